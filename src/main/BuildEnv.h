@@ -1,12 +1,76 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 
+/// the optimization pipeline that is run on the merged module of a program, like the -O options of clang
+enum class OptimizationLevel { O0, O1, O2, O3, Os };
+
+inline std::string to_string(OptimizationLevel level) {
+    switch (level) {
+    case OptimizationLevel::O0:
+        return "-O0";
+    case OptimizationLevel::O1:
+        return "-O1";
+    case OptimizationLevel::O2:
+        return "-O2";
+    case OptimizationLevel::O3:
+        return "-O3";
+    case OptimizationLevel::Os:
+        return "-Os";
+    }
+    return "";
+}
+
+/// parses a command line option like "-O2", returns std::nullopt for anything else
+inline std::optional<OptimizationLevel> parseOptimizationLevel(const std::string &option) {
+    for (auto level : {OptimizationLevel::O0, OptimizationLevel::O1, OptimizationLevel::O2, OptimizationLevel::O3,
+                       OptimizationLevel::Os}) {
+        if (option == to_string(level)) {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
+
 struct BuildEnv {
     std::string buildDirectory = "./neon-build/";
 
+    /// lex with the original regex based scanner instead of the table driven one (for A/B comparisons)
+    bool useRegexLexer = false;
+
+    /// parse while lexing and only keep the tokens of the current statement in memory (module->tokens stays empty)
+    bool streamTokens = true;
+
+    /// number of threads the compiler may use (large modules are lexed in parallel, if this is greater than one)
+    unsigned int numThreads = std::thread::hardware_concurrency();
+
+    /// keep the source segments of every module, so that edits can be applied with Compiler::updateModule
+    bool incrementalParsing = false;
+
+    /// reuse the ASTs of modules that have not changed since the last build (stored in buildDirectory/ast-cache)
+    bool useAstCache = false;
+
+    /// evaluate operations on literals and remove dead branches before generating IR (disable for A/B comparisons)
+    bool foldConstants = true;
+
+    /// promote the stack slots of locals and arguments to registers right after generating IR, even at O0
+    bool promoteAllocas = true;
+
+    /// link the bitcode of the standard library into the program if it has been built, so that it can be inlined
+    bool linkStdLibBitcode = true;
+
+    /// O0 emits the IR as it has been generated, all other levels run the standard LLVM pipeline on the whole program
+    OptimizationLevel optimizationLevel = OptimizationLevel::O0;
+
+    /// the cpu code is generated for (like -mcpu), "native" selects the cpu and all features of the host
+    std::string targetCpu = "generic";
+    /// comma separated features like "+avx2,-fma" (like -mattr), they are applied on top of the features of the cpu
+    std::string targetFeatures = {};
+
     explicit BuildEnv() { createBuildDir(); }
     explicit BuildEnv(std::string buildDir) : buildDirectory(std::move(buildDir)) {
         if (buildDirectory.back() != '/') {
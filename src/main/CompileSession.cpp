@@ -0,0 +1,76 @@
+#include "CompileSession.h"
+
+#include "Linker.h"
+#include "compiler/Compiler.h"
+#include "compiler/ast/Types.h"
+
+#include <mutex>
+
+namespace {
+
+std::mutex sessionsMutex;
+/// the number of sessions that currently own a program
+int sessionsWithProgram = 0;
+
+} // namespace
+
+CompileSession::CompileSession(BuildEnv buildEnv, const Logger &logger)
+    : buildEnv(std::move(buildEnv)), log(logger) {}
+
+CompileSession::~CompileSession() { reset(); }
+
+bool CompileSession::compile(const std::string &entryPoint) {
+    reset();
+    {
+        std::lock_guard lock(sessionsMutex);
+        sessionsWithProgram++;
+    }
+    program = std::make_unique<Program>(entryPoint);
+
+    // the compiler and its per module state only live for the duration of the compile, unless there can be edits
+    auto newCompiler = std::make_unique<Compiler>(program.get(), &buildEnv, log);
+    const bool error = newCompiler->run();
+    if (buildEnv.incrementalParsing) {
+        compiler = std::move(newCompiler);
+    }
+    return error;
+}
+
+bool CompileSession::recompile(const std::string &moduleFileName, std::size_t begin, std::size_t end,
+                               std::string_view replacement) {
+    if (compiler == nullptr) {
+        log.error("There is no program that has been compiled with incremental parsing");
+        return true;
+    }
+
+    if (compiler->updateModule(moduleFileName, begin, end, replacement)) {
+        return true;
+    }
+    return compiler->run();
+}
+
+bool CompileSession::link() {
+    if (program == nullptr) {
+        log.error("There is no program to link");
+        return true;
+    }
+
+    auto linker = Linker(program.get(), &buildEnv, log);
+    return linker.link();
+}
+
+void CompileSession::reset() {
+    if (program == nullptr) {
+        return;
+    }
+
+    compiler = nullptr;
+    program = nullptr;
+
+    // the type table is shared by all sessions, it can only be cleared once none of them has a program anymore
+    std::lock_guard lock(sessionsMutex);
+    sessionsWithProgram--;
+    if (sessionsWithProgram == 0) {
+        ast::resetTypes();
+    }
+}
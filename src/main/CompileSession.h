@@ -0,0 +1,54 @@
+#pragma once
+
+#include "BuildEnv.h"
+#include "Program.h"
+#include "compiler/Logger.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+class Compiler;
+
+/**
+ * Owns everything that belongs to the compilation of one program: the Program itself with its modules and their
+ * llvm::Modules, and the LLVMContext they live in. A session can compile any number of programs one after the other,
+ * each compile starts by releasing everything the previous one allocated, so that long-lived processes return to the
+ * same memory baseline between compiles.
+ *
+ * Tokens are freed as soon as a module has been parsed and ASTs as soon as the IR has been generated (unless
+ * BuildEnv::incrementalParsing needs them). With BuildEnv::incrementalParsing, the compiler of the last compile is kept
+ * around as well, so that the program can be edited and compiled again with recompile.
+ */
+class CompileSession {
+  public:
+    explicit CompileSession(BuildEnv buildEnv, const Logger &logger);
+    ~CompileSession();
+
+    /// compiles the program with the given entry point, returns true if there was an error
+    bool compile(const std::string &entryPoint);
+    /**
+     * Replaces the bytes [begin, end) of a module of the last compile with replacement and compiles the program again,
+     * only the statements affected by the edit are parsed again. Requires BuildEnv::incrementalParsing.
+     * Returns true if there was an error.
+     */
+    bool recompile(const std::string &moduleFileName, std::size_t begin, std::size_t end,
+                   std::string_view replacement);
+    /// links the program of the last successful compile, returns true if there was an error
+    bool link();
+    /// frees the program of the last compile, and the interned type names once no session has a program anymore
+    void reset();
+
+    BuildEnv &getBuildEnv() { return buildEnv; }
+    /// the program of the last compile, nullptr if there is none
+    [[nodiscard]] const Program *getProgram() const { return program.get(); }
+
+  private:
+    BuildEnv buildEnv;
+    const Logger &log;
+
+    std::unique_ptr<Program> program = nullptr;
+    /// only kept if BuildEnv::incrementalParsing is enabled, it refers to program
+    std::unique_ptr<Compiler> compiler;
+};
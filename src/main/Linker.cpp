@@ -108,13 +108,13 @@ std::string Linker::getLinkerCommand() {
 bool Linker::link() {
     std::string linkerCommand = getLinkerCommand();
 
-    log.debug("Calling linker with the following command:\n" + linkerCommand);
+    LOG_DEBUG(log, "Calling linker with the following command:\n" + linkerCommand);
 
     // TODO(henne): capture stdout and stderr. only print to console when verbose==true
     const char *command = linkerCommand.c_str();
     int statusCode = system(command);
 
-    log.debug("Finished linking.");
+    LOG_DEBUG(log, "Finished linking.");
 
     return statusCode != 0;
 }
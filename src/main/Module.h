@@ -8,16 +8,33 @@
 #include <filesystem>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+/// a range of whole source lines together with its tokens and the top level statements that have been parsed from it
+struct SourceSegment {
+    std::string code;
+    /// the tokens point into code
+    std::vector<Token> tokens = {};
+    std::vector<AstNode *> statements = {};
+};
+
 class Module {
   public:
     explicit Module(std::filesystem::path _filePath, llvm::LLVMContext &context)
-        : filePath(std::move(_filePath)), codeProvider(new FileCodeProvider(_filePath)),
-          llvmModule(_filePath.string(), context) {}
+        : fileCodeProvider(std::make_unique<FileCodeProvider>(_filePath)), codeProvider(fileCodeProvider.get()),
+          llvmModule(_filePath.string(), context), filePath(std::move(_filePath)) {}
+    /// creates the llvm::Module in an LLVMContext of its own, so that its IR can be generated on any thread
+    explicit Module(std::filesystem::path _filePath)
+        : fileCodeProvider(std::make_unique<FileCodeProvider>(_filePath)), codeProvider(fileCodeProvider.get()),
+          ownedContext(std::make_unique<llvm::LLVMContext>()), llvmModule(_filePath.string(), *ownedContext),
+          filePath(std::move(_filePath)) {}
+
+    Module(const Module &) = delete;
+    Module &operator=(const Module &) = delete;
 
     [[nodiscard]] std::string toString() const;
     [[nodiscard]] std::string toEscapedString() const;
@@ -28,11 +45,22 @@ class Module {
 
     CodeProvider *getCodeProvider() const;
 
+  private:
+    /// the provider for the file of the module, codeProvider points to it unless it has been replaced
+    std::unique_ptr<CodeProvider> fileCodeProvider;
+
   public:
     CodeProvider *codeProvider;
 
+  private:
+    /// only set if the module does not use the LLVMContext of the program, it has to outlive llvmModule
+    std::unique_ptr<llvm::LLVMContext> ownedContext = nullptr;
+
+  public:
     AST ast;
     std::vector<Token> tokens = {};
+    /// the source code of the module in order, only filled in if the module has been parsed by the IncrementalParser
+    std::vector<std::unique_ptr<SourceSegment>> segments = {};
 
     llvm::Module llvmModule;
 
@@ -12,6 +12,12 @@ Program::Program(std::string _entryPoint) : entryPoint(std::move(_entryPoint)) {
     name = entryPoint.substr(0, position);
 }
 
+Program::~Program() {
+    for (auto &entry : modules) {
+        delete entry.second;
+    }
+}
+
 std::string Program::objectFileName() const {
 #if WIN32
     return name + ".obj";
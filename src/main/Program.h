@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Module.h"
+#include "compiler/SymbolTable.h"
 
 #include <llvm/IR/LLVMContext.h>
 #include <string>
@@ -11,12 +12,19 @@ class Program {
   public:
     explicit Program(std::string entryPoint);
     explicit Program() = default;
+    ~Program();
+
+    Program(const Program &) = delete;
+    Program &operator=(const Program &) = delete;
 
     std::string entryPoint;
     std::string name;
 
+    /// the modules are owned by the program, they have to be destroyed before the llvmContext they were created in
     std::unordered_map<std::string, Module *> modules = {};
     llvm::LLVMContext llvmContext = {};
+    /// identifier names of all modules
+    SymbolTable symbols = {};
 
     [[nodiscard]] std::string objectFileName() const;
     [[nodiscard]] std::string executableFileName() const;
@@ -0,0 +1,617 @@
+#include "AstCache.h"
+
+#include <cstring>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'N', 'E', 'O', 'N', '-', 'A', 'S', 'T'};
+/// has to be increased whenever the layout of the entries or the meaning of the AST changes
+constexpr uint32_t FORMAT_VERSION = 1;
+/// marks a child that does not exist (e.g. a missing else body)
+constexpr uint32_t NO_NODE = UINT32_MAX;
+
+/**
+ * Layout of an entry (all numbers are stored in the byte order of the machine):
+ *   header:  magic, format version, size of the source code, hash of the source code
+ *   strings: count, then length and bytes of every string
+ *   nodes:   count, then one record per node (children come before their parents and are referenced by index)
+ *   root:    count and indices of the top level statements
+ *   state:   imports (relative to the module), function signatures and complex types
+ */
+class Encoder {
+  public:
+    explicit Encoder(const SymbolTable &symbols) : symbols(symbols) {}
+
+    std::string finish(std::string_view code) {
+        std::string result;
+        result.append(MAGIC, sizeof(MAGIC));
+        writeTo(result, FORMAT_VERSION);
+        writeTo(result, static_cast<uint64_t>(code.size()));
+        writeTo(result, static_cast<uint64_t>(llvm::xxHash64(code)));
+        writeTo(result, static_cast<uint32_t>(strings.size()));
+        for (const auto &string : strings) {
+            writeTo(result, static_cast<uint32_t>(string.size()));
+            result.append(string);
+        }
+        writeTo(result, numNodes);
+        result.append(nodes);
+        result.append(rest);
+        return result;
+    }
+
+    void writeRoot(AstNode *root) {
+        std::vector<uint32_t> children = {};
+        for (auto *child : root->sequence.children) {
+            children.push_back(writeNode(child));
+        }
+        write(static_cast<uint32_t>(children.size()));
+        for (auto child : children) {
+            write(child);
+        }
+    }
+
+    void writeState(const ModuleCompileState &state, const std::filesystem::path &moduleDirectory) {
+        write(static_cast<uint32_t>(state.imports.size()));
+        for (const auto &import : state.imports) {
+            // the same code can be imported from several directories
+            auto relativePath = moduleDirectory.empty()
+                                      ? std::filesystem::path(import)
+                                      : std::filesystem::path(import).lexically_relative(moduleDirectory);
+            write(stringIndex(relativePath.string()));
+        }
+
+        write(static_cast<uint32_t>(state.functions.size()));
+        for (const auto &function : state.functions) {
+            write(stringIndex(symbols.name(function.name)));
+            write(stringIndex(function.returnType.name()));
+            write(static_cast<uint32_t>(function.arguments.size()));
+            for (const auto &argument : function.arguments) {
+                write(stringIndex(symbols.name(argument.name)));
+                write(stringIndex(argument.type.name()));
+            }
+        }
+
+        write(static_cast<uint32_t>(state.complexTypes.size()));
+        for (const auto &complexType : state.complexTypes) {
+            write(stringIndex(complexType.type.name()));
+            write(static_cast<uint32_t>(complexType.members.size()));
+            for (const auto &member : complexType.members) {
+                write(stringIndex(symbols.name(member.name)));
+                write(stringIndex(member.type.name()));
+            }
+        }
+    }
+
+  private:
+    const SymbolTable &symbols;
+    std::vector<std::string> strings = {};
+    std::unordered_map<std::string, uint32_t> stringIndices = {};
+    uint32_t numNodes = 0;
+    std::string nodes = {};
+    std::string rest = {};
+
+    template <typename T> static void writeTo(std::string &buffer, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        buffer.append(bytes, sizeof(T));
+    }
+    template <typename T> void write(T value) { writeTo(rest, value); }
+
+    uint32_t stringIndex(const std::string &string) {
+        auto itr = stringIndices.find(string);
+        if (itr != stringIndices.end()) {
+            return itr->second;
+        }
+        const auto index = static_cast<uint32_t>(strings.size());
+        strings.push_back(string);
+        stringIndices[string] = index;
+        return index;
+    }
+
+    uint32_t writeChild(AstNode *node) { return node == nullptr ? NO_NODE : writeNode(node); }
+
+    template <typename T> std::vector<uint32_t> writeChildren(const AstNodeSpan<T> &children) {
+        std::vector<uint32_t> result = {};
+        result.reserve(children.size());
+        for (auto *child : children) {
+            result.push_back(writeNode(AST_NODE(child)));
+        }
+        return result;
+    }
+
+    /// writes the children first and then the node itself, returns the index of the node
+    uint32_t writeNode(AstNode *node) {
+        std::string record;
+        auto put = [&record](auto value) { writeTo(record, value); };
+        auto putList = [&record](const std::vector<uint32_t> &indices) {
+            writeTo(record, static_cast<uint32_t>(indices.size()));
+            for (auto index : indices) {
+                writeTo(record, index);
+            }
+        };
+
+        put(static_cast<uint8_t>(node->type));
+        switch (node->type) {
+        case ast::NodeType::SEQUENCE:
+            putList(writeChildren(node->sequence.children));
+            break;
+        case ast::NodeType::STATEMENT:
+            put(writeChild(node->statement.child));
+            put(static_cast<uint8_t>(node->statement.returnStatement));
+            break;
+        case ast::NodeType::LITERAL:
+            put(static_cast<uint8_t>(node->literal.type));
+            switch (node->literal.type) {
+            case LiteralType::BOOL:
+                put(static_cast<uint8_t>(node->literal.b));
+                break;
+            case LiteralType::INTEGER:
+                put(node->literal.i);
+                break;
+            case LiteralType::FLOAT:
+                put(node->literal.d);
+                break;
+            case LiteralType::STRING:
+                put(stringIndex(symbols.name(node->literal.s)));
+                break;
+            }
+            break;
+        case ast::NodeType::UNARY_OPERATION:
+            put(static_cast<uint8_t>(node->unary_operation.type));
+            put(writeChild(node->unary_operation.child));
+            break;
+        case ast::NodeType::BINARY_OPERATION:
+            put(static_cast<uint8_t>(node->binary_operation.type));
+            put(writeChild(node->binary_operation.left));
+            put(writeChild(node->binary_operation.right));
+            break;
+        case ast::NodeType::FUNCTION:
+            put(stringIndex(symbols.name(node->function.name)));
+            put(stringIndex(node->function.returnType.name()));
+            put(writeChild(node->function.body));
+            putList(writeChildren(node->function.arguments));
+            break;
+        case ast::NodeType::CALL:
+            put(stringIndex(symbols.name(node->call.name)));
+            putList(writeChildren(node->call.arguments));
+            break;
+        case ast::NodeType::VARIABLE_DEFINITION:
+            put(stringIndex(symbols.name(node->variable_definition.name)));
+            put(stringIndex(node->variable_definition.type.name()));
+            put(node->variable_definition.arraySize);
+            break;
+        case ast::NodeType::VARIABLE:
+            put(stringIndex(symbols.name(node->variable.name)));
+            put(writeChild(node->variable.arrayIndex));
+            break;
+        case ast::NodeType::ASSIGNMENT:
+            put(writeChild(node->assignment.left));
+            put(writeChild(node->assignment.right));
+            break;
+        case ast::NodeType::IF_STATEMENT:
+            put(writeChild(node->if_statement.condition));
+            put(writeChild(node->if_statement.ifBody));
+            put(writeChild(node->if_statement.elseBody));
+            break;
+        case ast::NodeType::FOR_STATEMENT:
+            put(writeChild(node->for_statement.init));
+            put(writeChild(node->for_statement.condition));
+            put(writeChild(node->for_statement.update));
+            put(writeChild(node->for_statement.body));
+            break;
+        case ast::NodeType::IMPORT:
+            put(stringIndex(symbols.name(node->import.fileName)));
+            break;
+        case ast::NodeType::TYPE_DECLARATION:
+            put(stringIndex(symbols.name(node->type_declaration.name)));
+            putList(writeChildren(node->type_declaration.members));
+            break;
+        case ast::NodeType::TYPE_MEMBER:
+            put(writeChild(AST_NODE(node->type_member.variable_definition)));
+            break;
+        case ast::NodeType::MEMBER_ACCESS:
+            put(writeChild(node->member_access.left));
+            put(writeChild(node->member_access.right));
+            break;
+        case ast::NodeType::ASSERT:
+            put(writeChild(node->assert.condition));
+            break;
+        case ast::NodeType::COMMENT:
+            put(stringIndex(symbols.name(node->comment.content)));
+            break;
+        }
+
+        nodes.append(record);
+        return numNodes++;
+    }
+};
+
+/// reads an entry that has been written by the Encoder, every read is bounds checked and sets failed on error
+class Decoder {
+  public:
+    Decoder(std::string_view data, SymbolTable &symbols, AST &tree) : data(data), symbols(symbols), tree(tree) {}
+
+    bool readHeader(std::string_view code) {
+        if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            return false;
+        }
+        position = sizeof(MAGIC);
+        const auto version = read<uint32_t>();
+        const auto codeSize = read<uint64_t>();
+        const auto codeHash = read<uint64_t>();
+        return !failed && version == FORMAT_VERSION && codeSize == code.size() && codeHash == llvm::xxHash64(code);
+    }
+
+    bool readStrings() {
+        const auto numStrings = read<uint32_t>();
+        for (uint32_t i = 0; i < numStrings && !failed; i++) {
+            const auto size = read<uint32_t>();
+            if (failed || size > data.size() - position) {
+                failed = true;
+                break;
+            }
+            strings.push_back(data.substr(position, size));
+            position += size;
+        }
+        symbolIds.assign(strings.size(), NO_SYMBOL);
+        return !failed;
+    }
+
+    bool readNodes() {
+        const auto numNodes = read<uint32_t>();
+        if (!failed && numNodes > data.size() - position) {
+            // every record takes at least one byte
+            failed = true;
+        }
+        if (!failed) {
+            nodes.reserve(numNodes);
+        }
+        for (uint32_t i = 0; i < numNodes && !failed; i++) {
+            auto *node = readNode();
+            if (node != nullptr) {
+                nodes.push_back(node);
+            }
+        }
+        return !failed;
+    }
+
+    bool readRoot() {
+        auto children = readList<AstNode>({});
+        if (failed) {
+            return false;
+        }
+        tree.root()->sequence.children = tree.createSpan(children);
+        return true;
+    }
+
+    bool readState(ModuleCompileState &state, const std::filesystem::path &moduleDirectory) {
+        const auto numImports = read<uint32_t>();
+        for (uint32_t i = 0; i < numImports && !failed; i++) {
+            const auto relativePath = std::filesystem::path(readString());
+            state.imports.push_back((moduleDirectory / relativePath).string());
+        }
+
+        const auto numFunctions = read<uint32_t>();
+        for (uint32_t i = 0; i < numFunctions && !failed; i++) {
+            FunctionSignature signature = {
+                  .name = readSymbol(),
+                  .returnType = ast::DataType(readString()),
+            };
+            const auto numArguments = read<uint32_t>();
+            for (uint32_t j = 0; j < numArguments && !failed; j++) {
+                FunctionArgument argument = {
+                      .name = readSymbol(),
+                      .type = ast::DataType(readString()),
+                };
+                signature.arguments.push_back(argument);
+            }
+            state.functions.push_back(signature);
+        }
+
+        const auto numComplexTypes = read<uint32_t>();
+        for (uint32_t i = 0; i < numComplexTypes && !failed; i++) {
+            ComplexType complexType = {.type = ast::DataType(readString())};
+            const auto numMembers = read<uint32_t>();
+            for (uint32_t j = 0; j < numMembers && !failed; j++) {
+                ComplexTypeMember member = {
+                      .name = readSymbol(),
+                      .type = ast::DataType(readString()),
+                };
+                complexType.members.push_back(member);
+            }
+            state.complexTypes.push_back(complexType);
+        }
+
+        return !failed && position == data.size();
+    }
+
+  private:
+    std::string_view data;
+    std::size_t position = 0;
+    bool failed = false;
+
+    SymbolTable &symbols;
+    AST &tree;
+    std::vector<std::string_view> strings = {};
+    /// the strings are only interned once they are used as a name
+    std::vector<SymbolId> symbolIds = {};
+    std::vector<AstNode *> nodes = {};
+
+    template <typename T> T read() {
+        T value = {};
+        if (failed || data.size() - position < sizeof(T)) {
+            failed = true;
+            return value;
+        }
+        std::memcpy(&value, data.data() + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    std::string_view readString() {
+        const auto index = read<uint32_t>();
+        if (failed || index >= strings.size()) {
+            failed = true;
+            return {};
+        }
+        return strings[index];
+    }
+
+    SymbolId readSymbol() {
+        const auto index = read<uint32_t>();
+        if (failed || index >= strings.size()) {
+            failed = true;
+            return NO_SYMBOL;
+        }
+        if (symbolIds[index] == NO_SYMBOL) {
+            symbolIds[index] = symbols.intern(strings[index]);
+        }
+        return symbolIds[index];
+    }
+
+    /// reads an enum that is stored as one byte, values after the last enumerator are rejected
+    template <typename T> T readEnum(T last) {
+        const auto value = read<uint8_t>();
+        if (value > static_cast<uint8_t>(last)) {
+            failed = true;
+        }
+        return static_cast<T>(value);
+    }
+
+    /// returns nullptr for NO_NODE, expectedType is only checked if it is given
+    AstNode *readChild(std::optional<ast::NodeType> expectedType = {}) {
+        const auto index = read<uint32_t>();
+        if (failed || index == NO_NODE) {
+            return nullptr;
+        }
+        if (index >= nodes.size() || (expectedType.has_value() && nodes[index]->type != expectedType.value())) {
+            failed = true;
+            return nullptr;
+        }
+        return nodes[index];
+    }
+
+    /// like readChild, but a missing child makes the entry invalid
+    AstNode *readRequiredChild(std::optional<ast::NodeType> expectedType = {}) {
+        auto *node = readChild(expectedType);
+        if (node == nullptr) {
+            failed = true;
+        }
+        return node;
+    }
+
+    template <typename T> std::vector<T *> readList(std::optional<ast::NodeType> expectedType) {
+        std::vector<T *> result = {};
+        const auto count = read<uint32_t>();
+        for (uint32_t i = 0; i < count && !failed; i++) {
+            auto *child = readChild(expectedType);
+            if (child == nullptr) {
+                failed = true;
+                break;
+            }
+            result.push_back(reinterpret_cast<T *>(child));
+        }
+        return result;
+    }
+
+    SequenceNode *readSequence() {
+        auto *node = readChild(ast::NodeType::SEQUENCE);
+        return node == nullptr ? nullptr : &node->sequence;
+    }
+
+    SequenceNode *readRequiredSequence() {
+        auto *node = readRequiredChild(ast::NodeType::SEQUENCE);
+        return node == nullptr ? nullptr : &node->sequence;
+    }
+
+    StatementNode *readRequiredStatement() {
+        auto *node = readRequiredChild(ast::NodeType::STATEMENT);
+        return node == nullptr ? nullptr : &node->statement;
+    }
+
+    AstNode *readNode() {
+        const auto type = static_cast<ast::NodeType>(read<uint8_t>());
+        if (failed) {
+            return nullptr;
+        }
+
+        switch (type) {
+        case ast::NodeType::SEQUENCE:
+            return AST_NODE(tree.createSequence(readList<AstNode>({})));
+        case ast::NodeType::STATEMENT: {
+            auto *child = readRequiredChild();
+            const bool isReturn = read<uint8_t>() != 0;
+            return AST_NODE(tree.createStatement(child, isReturn));
+        }
+        case ast::NodeType::LITERAL:
+            switch (static_cast<LiteralType>(read<uint8_t>())) {
+            case LiteralType::BOOL:
+                return AST_NODE(tree.createLiteralBool(read<uint8_t>() != 0));
+            case LiteralType::INTEGER:
+                return AST_NODE(tree.createLiteralInteger(read<int64_t>()));
+            case LiteralType::FLOAT:
+                return AST_NODE(tree.createLiteralFloat(read<double>()));
+            case LiteralType::STRING:
+                return AST_NODE(tree.createLiteralString(readSymbol()));
+            }
+            break;
+        case ast::NodeType::UNARY_OPERATION: {
+            const auto operationType = readEnum(ast::UnaryOperationType::NEGATE);
+            return AST_NODE(tree.createUnaryOperation(operationType, readRequiredChild()));
+        }
+        case ast::NodeType::BINARY_OPERATION: {
+            const auto operationType = readEnum(ast::BinaryOperationType::OR);
+            auto *left = readRequiredChild();
+            auto *right = readRequiredChild();
+            return AST_NODE(tree.createBinaryOperation(operationType, left, right));
+        }
+        case ast::NodeType::FUNCTION: {
+            const auto name = readSymbol();
+            auto returnType = ast::DataType(readString());
+            auto *body = readSequence();
+            auto arguments = readList<VariableDefinitionNode>(ast::NodeType::VARIABLE_DEFINITION);
+            return AST_NODE(tree.createFunction(name, returnType, arguments, body));
+        }
+        case ast::NodeType::CALL: {
+            const auto name = readSymbol();
+            return AST_NODE(tree.createCall(name, readList<AstNode>({})));
+        }
+        case ast::NodeType::VARIABLE_DEFINITION: {
+            const auto name = readSymbol();
+            auto dataType = ast::DataType(readString());
+            return AST_NODE(tree.createVariableDefinition(name, dataType, read<int64_t>()));
+        }
+        case ast::NodeType::VARIABLE: {
+            const auto name = readSymbol();
+            return AST_NODE(tree.createVariable(name, readChild()));
+        }
+        case ast::NodeType::ASSIGNMENT: {
+            auto *left = readRequiredChild();
+            auto *right = readRequiredChild();
+            return AST_NODE(tree.createAssignment(left, right));
+        }
+        case ast::NodeType::IF_STATEMENT: {
+            auto *condition = readRequiredChild();
+            // empty bodies are stored as missing children
+            auto *ifBody = readSequence();
+            auto *elseBody = readSequence();
+            return AST_NODE(tree.createIf(condition, ifBody, elseBody));
+        }
+        case ast::NodeType::FOR_STATEMENT: {
+            auto *init = readRequiredStatement();
+            auto *condition = readRequiredChild();
+            auto *update = readRequiredStatement();
+            auto *body = readRequiredSequence();
+            return AST_NODE(tree.createFor(init, condition, update, body));
+        }
+        case ast::NodeType::IMPORT:
+            return AST_NODE(tree.createImport(readSymbol()));
+        case ast::NodeType::TYPE_DECLARATION: {
+            const auto name = readSymbol();
+            return AST_NODE(tree.createTypeDeclaration(name, readList<TypeMemberNode>(ast::NodeType::TYPE_MEMBER)));
+        }
+        case ast::NodeType::TYPE_MEMBER: {
+            auto *variableDefinition = readRequiredChild(ast::NodeType::VARIABLE_DEFINITION);
+            if (variableDefinition == nullptr) {
+                break;
+            }
+            return AST_NODE(tree.createTypeMember(&variableDefinition->variable_definition));
+        }
+        case ast::NodeType::MEMBER_ACCESS: {
+            auto *left = readRequiredChild();
+            auto *right = readRequiredChild();
+            return AST_NODE(tree.createMemberAccess(left, right));
+        }
+        case ast::NodeType::ASSERT:
+            return AST_NODE(tree.createAssert(readRequiredChild()));
+        case ast::NodeType::COMMENT:
+            return AST_NODE(tree.createComment(readSymbol()));
+        }
+
+        failed = true;
+        return nullptr;
+    }
+};
+
+} // namespace
+
+std::filesystem::path AstCache::entryPath(std::string_view code) const {
+    std::ostringstream fileName;
+    fileName << std::hex << std::setw(16) << std::setfill('0') << llvm::xxHash64(code) << ".ast";
+    return directory / fileName.str();
+}
+
+bool AstCache::load(Module *module, std::string_view code, ModuleCompileState &state) {
+    const auto path = entryPath(code);
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+
+    auto codeProvider = FileCodeProvider(path);
+    auto data = codeProvider.getRemainingCode().value_or(std::string_view());
+    auto decoder = Decoder(data, symbols, module->ast);
+    if (!decoder.readHeader(code)) {
+        LOG_DEBUG(log, "Ignoring outdated AST cache entry " + path.string());
+        return false;
+    }
+
+    ModuleCompileState cachedState = {};
+    if (!decoder.readStrings() || !decoder.readNodes() || !decoder.readRoot() ||
+        !decoder.readState(cachedState, module->getDirectoryPath())) {
+        log.warn("Ignoring corrupt AST cache entry " + path.string());
+        return false;
+    }
+
+    module->ast.completed();
+    state.imports = std::move(cachedState.imports);
+    state.functions = std::move(cachedState.functions);
+    state.complexTypes = std::move(cachedState.complexTypes);
+    return true;
+}
+
+void AstCache::store(Module *module, std::string_view code, const ModuleCompileState &state) {
+    auto encoder = Encoder(symbols);
+    encoder.writeRoot(module->ast.root());
+    encoder.writeState(state, module->getDirectoryPath());
+    const auto entry = encoder.finish(code);
+
+    std::error_code error = {};
+    std::filesystem::create_directories(directory, error);
+
+    // modules with the same code might be stored at the same time, the rename makes sure that readers never see a
+    // partially written entry. The temporary file gets a name that is unique across threads and processes.
+    const auto path = entryPath(code);
+    int fileDescriptor = -1;
+    llvm::SmallString<128> temporaryName = {};
+    if (llvm::sys::fs::createUniqueFile(path.string() + ".%%%%%%%%.tmp", fileDescriptor, temporaryName)) {
+        LOG_DEBUG(log, "Could not create a temporary file for AST cache entry " + path.string());
+        return;
+    }
+    const auto temporaryPath = std::filesystem::path(temporaryName.str().str());
+    {
+        llvm::raw_fd_ostream file(fileDescriptor, true);
+        file.write(entry.data(), entry.size());
+        file.close();
+        if (file.has_error()) {
+            file.clear_error();
+            LOG_DEBUG(log, "Could not write AST cache entry " + temporaryPath.string());
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        LOG_DEBUG(log, "Could not write AST cache entry " + path.string() + ": " + error.message());
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
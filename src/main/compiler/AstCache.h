@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../Module.h"
+#include "Logger.h"
+#include "MetaTypes.h"
+#include "ModuleCompileState.h"
+#include "SymbolTable.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+/**
+ * Stores the AST and the declarations (imports, functions and complex types) of parsed modules in the build directory,
+ * so that modules that have not changed since the last build don't have to be lexed and parsed again.
+ *
+ * The entries are keyed by a hash of the source code. They are mapped into memory and decoded straight into the AST of
+ * the module. Names are stored as strings and interned again while decoding, because SymbolIds are only valid within
+ * one SymbolTable.
+ */
+class AstCache {
+  public:
+    AstCache(const Logger &log, SymbolTable &symbols, std::filesystem::path directory)
+        : log(log), symbols(symbols), directory(std::move(directory)) {}
+
+    /**
+     * Fills in the AST of the module and its declarations from the entry for code.
+     * Returns false, if there is no usable entry. The AST might contain unreachable nodes in that case.
+     */
+    bool load(Module *module, std::string_view code, ModuleCompileState &state);
+
+    /// creates or replaces the entry for code, failing to write it is not an error
+    void store(Module *module, std::string_view code, const ModuleCompileState &state);
+
+    [[nodiscard]] std::filesystem::path entryPath(std::string_view code) const;
+
+  private:
+    const Logger &log;
+    SymbolTable &symbols;
+    std::filesystem::path directory;
+};
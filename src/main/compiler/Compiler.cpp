@@ -1,66 +1,194 @@
 #include "Compiler.h"
 
+#include "AstCache.h"
 #include "FunctionResolver.h"
 #include "ast/visitors/AstPrinter.h"
 #include "ast/visitors/AstTestCasePrinter.h"
 #include "ast/visitors/ComplexTypeFinder.h"
+#include "ast/visitors/ConstantFolder.h"
 #include "ast/visitors/FunctionFinder.h"
 #include "ast/visitors/ImportFinder.h"
 #include "ast/visitors/TypeAnalyzer.h"
 #include "ir/IrGenerator.h"
+#include "parser/IncrementalParser.h"
 #include "parser/Parser.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/IPO/Internalize.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+namespace {
+
+llvm::PassBuilder::OptimizationLevel toLlvmOptimizationLevel(OptimizationLevel level) {
+    switch (level) {
+    case OptimizationLevel::O0:
+        return llvm::PassBuilder::OptimizationLevel::O0;
+    case OptimizationLevel::O1:
+        return llvm::PassBuilder::OptimizationLevel::O1;
+    case OptimizationLevel::O2:
+        return llvm::PassBuilder::OptimizationLevel::O2;
+    case OptimizationLevel::O3:
+        return llvm::PassBuilder::OptimizationLevel::O3;
+    case OptimizationLevel::Os:
+        return llvm::PassBuilder::OptimizationLevel::Os;
+    }
+    return llvm::PassBuilder::OptimizationLevel::O0;
+}
+
+/// removes everything that has been generated into the module, so that its IR can be generated again after an edit
+void eraseGeneratedIR(llvm::Module &module) {
+    // the functions and globals reference each other, nothing can be erased while it is still in use
+    module.dropAllReferences();
+    while (!module.empty()) {
+        auto &function = *module.begin();
+        function.removeDeadConstantUsers();
+        function.eraseFromParent();
+    }
+    while (!module.global_empty()) {
+        auto &global = *module.global_begin();
+        global.removeDeadConstantUsers();
+        global.eraseFromParent();
+    }
+}
+
+llvm::CodeGenOpt::Level toCodeGenOptLevel(OptimizationLevel level) {
+    switch (level) {
+    case OptimizationLevel::O0:
+        return llvm::CodeGenOpt::None;
+    case OptimizationLevel::O1:
+        return llvm::CodeGenOpt::Less;
+    case OptimizationLevel::O2:
+    case OptimizationLevel::Os:
+        return llvm::CodeGenOpt::Default;
+    case OptimizationLevel::O3:
+        return llvm::CodeGenOpt::Aggressive;
+    }
+    return llvm::CodeGenOpt::None;
+}
+
+std::string getHostCpuFeatures() {
+    llvm::StringMap<bool> hostFeatures = {};
+    if (!llvm::sys::getHostCPUFeatures(hostFeatures)) {
+        return "";
+    }
+
+    std::vector<std::string> features = {};
+    for (const auto &entry : hostFeatures) {
+        features.push_back((entry.getValue() ? "+" : "-") + entry.getKey().str());
+    }
+    // the order of a StringMap is not deterministic, but the feature string ends up in the generated IR
+    std::sort(features.begin(), features.end());
+
+    std::string result = {};
+    for (const auto &feature : features) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += feature;
+    }
+    return result;
+}
+
+} // namespace
+
 bool Compiler::run() {
-    std::vector<std::string> uncompiledModulePaths = {program->entryPoint};
-    while (!uncompiledModulePaths.empty()) {
-        std::string moduleFileName = uncompiledModulePaths.back();
-        uncompiledModulePaths.pop_back();
-
-        auto itr = program->modules.find(moduleFileName);
-        bool moduleAlreadyExists = itr != program->modules.end();
-        if (moduleAlreadyExists) {
-            log.debug("Skipping " + moduleFileName + " because it has already been processed");
-            continue;
+    if (buildEnv->numThreads > 1 && threadPool == nullptr) {
+        threadPool = std::make_unique<ThreadPool>(buildEnv->numThreads);
+        modulePool = std::make_unique<ThreadPool>(buildEnv->numThreads);
+    }
+
+    std::deque<PendingModule> pendingModules = {};
+    dispatchModule(program->entryPoint, pendingModules);
+    // after an edit, the modules that have already been loaded might import modules that have not been loaded yet
+    for (const auto &entry : moduleCompileState) {
+        for (const auto &importedModule : entry.second.imports) {
+            dispatchModule(importedModule, pendingModules);
+        }
+    }
+
+    bool error = false;
+    while (!pendingModules.empty()) {
+        // take whichever module is done first, so that its imports can start right away
+        auto itr = std::find_if(pendingModules.begin(), pendingModules.end(), [](const PendingModule &pendingModule) {
+            return pendingModule.success.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+        if (itr == pendingModules.end()) {
+            itr = pendingModules.begin();
+        }
+        auto pendingModule = std::move(*itr);
+        pendingModules.erase(itr);
+
+        const bool success = pendingModule.success.get();
+        if (pendingModule.logBuffer != nullptr) {
+            log.append(pendingModule.logBuffer->str());
         }
 
-        auto *module = loadModule(moduleFileName);
-        if (!module->ast.is_complete()) {
-            log.error("Failed to compile module " + moduleFileName);
-            return true;
+        // the remaining modules still have to be waited for, because they are using the pending modules
+        if (!success) {
+            log.error("Failed to compile module " + pendingModule.module->getFilePath().string());
+            error = true;
+        }
+        if (error) {
+            continue;
         }
-        program->modules[moduleFileName] = module;
 
-        for (auto &importedModule : moduleCompileState[module].imports) {
-            uncompiledModulePaths.push_back(importedModule);
+        auto &state = moduleCompileState[pendingModule.module];
+        state = std::move(*pendingModule.state);
+        for (auto &importedModule : state.imports) {
+            dispatchModule(importedModule, pendingModules);
         }
     }
 
+    if (error) {
+        return true;
+    }
+
+    symbolIndex = SymbolIndex(program, moduleCompileState, log);
+
     analyseTypes();
 
-    generateIR();
+    if (buildEnv->foldConstants) {
+        foldConstants();
+    }
+
+    if (generateIR()) {
+        return true;
+    }
 
     writeModuleToObjectFile();
 
-    log.debug("Finished compilation.");
+    LOG_DEBUG(log, "Finished compilation.");
     return false;
 }
 
-Module *Compiler::loadModule(const std::string &moduleFileName) {
-    auto *module = new Module(moduleFileName, program->llvmContext);
+void Compiler::dispatchModule(const std::string &moduleFileName, std::deque<PendingModule> &pendingModules) {
+    auto itr = program->modules.find(moduleFileName);
+    bool moduleAlreadyExists = itr != program->modules.end();
+    if (moduleAlreadyExists) {
+        LOG_DEBUG(log, "Skipping " + moduleFileName + " because it has already been processed");
+        return;
+    }
+
+    // an LLVMContext is not thread safe, modules that are generated in parallel need one of their own
+    auto *module =
+          modulePool == nullptr ? new Module(moduleFileName, program->llvmContext) : new Module(moduleFileName);
+    program->modules[moduleFileName] = module;
 
     if (module->getFilePath().has_parent_path()) {
         const auto moduleBuildDir =
@@ -68,17 +196,87 @@ Module *Compiler::loadModule(const std::string &moduleFileName) {
         std::filesystem::create_directories(moduleBuildDir);
     }
 
-    Lexer lexer(module->getCodeProvider(), log);
+    PendingModule pendingModule = {
+          .module = module,
+          .state = std::make_unique<ModuleCompileState>(),
+    };
+    auto *state = pendingModule.state.get();
+    if (modulePool == nullptr) {
+        pendingModule.success = std::async(std::launch::deferred, [this, module, state]() {
+            return loadModule(module, log, *state);
+        });
+    } else {
+        pendingModule.logBuffer = std::make_unique<std::ostringstream>();
+        pendingModule.log = std::make_unique<Logger>(log);
+        pendingModule.log->setOutput(pendingModule.logBuffer.get());
+        auto *moduleLog = pendingModule.log.get();
+        pendingModule.success = modulePool->submit([this, module, moduleLog, state]() {
+            return loadModule(module, *moduleLog, *state);
+        });
+    }
+    pendingModules.push_back(std::move(pendingModule));
+}
+
+bool Compiler::loadModule(Module *module, const Logger &moduleLog, ModuleCompileState &state) {
+    const auto moduleFileName = module->getFilePath().string();
+    if (buildEnv->incrementalParsing) {
+        if (!IncrementalParser(moduleLog, program->symbols).run(module)) {
+            moduleLog.error("Could not parse '" + moduleFileName + "'");
+            return false;
+        }
+        findDeclarations(module, state);
+        return true;
+    }
+
+    if (buildEnv->useAstCache) {
+        return loadCachedModule(module, moduleLog, state);
+    }
+
+    return parseModule(module, module->getCodeProvider(), moduleLog, state);
+}
+
+bool Compiler::loadCachedModule(Module *module, const Logger &moduleLog, ModuleCompileState &state) {
+    auto *codeProvider = module->getCodeProvider();
+    // the code stays mapped into memory for as long as the module exists, the tokens can point into it
+    const auto code = codeProvider->getRemainingCode();
+    if (!code.has_value()) {
+        return parseModule(module, codeProvider, moduleLog, state);
+    }
+
+    auto astCache =
+          AstCache(moduleLog, program->symbols, std::filesystem::path(buildEnv->buildDirectory) / "ast-cache");
+    if (astCache.load(module, code.value(), state)) {
+        LOG_DEBUG(moduleLog, "Loaded '" + module->getFilePath().string() + "' from the AST cache");
+        return true;
+    }
+
+    auto bufferCodeProvider = BufferCodeProvider(code.value());
+    if (!parseModule(module, &bufferCodeProvider, moduleLog, state)) {
+        return false;
+    }
+    astCache.store(module, code.value(), state);
+    return true;
+}
+
+bool Compiler::parseModule(Module *module, CodeProvider *codeProvider, const Logger &moduleLog,
+                           ModuleCompileState &state) {
+    const auto moduleFileName = module->getFilePath().string();
+    const auto lexerMode = buildEnv->useRegexLexer ? Lexer::Mode::REGEX : Lexer::Mode::TABLE_DRIVEN;
+    Lexer lexer(codeProvider, moduleLog, lexerMode, &program->symbols);
+    if (threadPool != nullptr) {
+        lexer.lexInParallel(*threadPool);
+    }
 
-    Parser parser(log, lexer);
+    const auto parserMode = buildEnv->streamTokens ? Parser::Mode::STREAMING : Parser::Mode::BUFFERED;
+    Parser parser(moduleLog, lexer, program->symbols, parserMode);
     parser.run(module);
 
     if (!module->ast.is_complete()) {
-        log.error("Could not parse '" + moduleFileName + "'");
-        return module;
+        moduleLog.error("Could not parse '" + moduleFileName + "'");
+        return false;
     }
 
-    if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
+    if (moduleLog.getLogLevel() == Logger::LogLevel::DEBUG_) {
         // TODO enable this again
         //        auto astPrinter = AstPrinter(module);
         //        astPrinter.run();
@@ -87,36 +285,141 @@ Module *Compiler::loadModule(const std::string &moduleFileName) {
         //        astTestCasePrinter.run();
     }
 
-    moduleCompileState[module].imports = ImportFinder(module->getDirectoryPath()).run(module->ast);
-    moduleCompileState[module].functions = FunctionFinder().run(module->ast);
-    moduleCompileState[module].complexTypes = ComplexTypeFinder().run(module->ast);
+    findDeclarations(module, state);
+
+    // everything that is needed later on is in the AST now
+    std::vector<Token>().swap(module->tokens);
 
-    return module;
+    return true;
 }
 
-void Compiler::generateIR() {
-    auto functionResolver = FunctionResolver(program, moduleCompileState);
+void Compiler::findDeclarations(Module *module, ModuleCompileState &state) {
+    auto importFinder = ImportFinder(program->symbols, module->getDirectoryPath());
+    auto functionFinder = FunctionFinder(program->symbols);
+    auto complexTypeFinder = ComplexTypeFinder(program->symbols);
+    visitDeclarations(module->ast.root(), importFinder, functionFinder, complexTypeFinder);
+    state.imports = std::move(importFinder.getImportedModules());
+    state.functions = std::move(functionFinder.getFunctions());
+    state.complexTypes = std::move(complexTypeFinder.getTypes());
+}
+
+bool Compiler::updateModule(const std::string &moduleFileName, std::size_t begin, std::size_t end,
+                            std::string_view replacement) {
+    auto itr = program->modules.find(moduleFileName);
+    if (itr == program->modules.end()) {
+        log.error("Module '" + moduleFileName + "' has not been loaded");
+        return true;
+    }
+
+    auto *module = itr->second;
+    if (module->segments.empty()) {
+        log.error("Module '" + moduleFileName + "' has not been parsed incrementally");
+        return true;
+    }
+
+    auto parser = IncrementalParser(log, program->symbols);
+    if (!parser.applyEdit(module, begin, end, replacement)) {
+        log.error("Could not parse '" + moduleFileName + "' after the edit");
+        return true;
+    }
+    LOG_DEBUG(log, "Re-parsed " + std::to_string(parser.getReparsedBytes()) + " bytes of '" + moduleFileName + "'");
+
+    findDeclarations(module, moduleCompileState[module]);
+    // the index points into the declarations that have just been replaced
+    symbolIndex = SymbolIndex(program, moduleCompileState, log);
+    return false;
+}
+
+bool Compiler::generateIR() {
+    auto functionResolver = FunctionResolver(symbolIndex);
+    bool error = false;
+    if (modulePool == nullptr) {
+        for (const auto &entry : program->modules) {
+            error |= generateModuleIR(entry.second, functionResolver, log);
+        }
+        return error;
+    }
+
+    // every module has its own LLVMContext, their IR is written to bitcode and read back in by mergeModules
+    struct PendingIR {
+        std::unique_ptr<std::ostringstream> logBuffer = nullptr;
+        std::unique_ptr<Logger> log = nullptr;
+        std::future<bool> error = {};
+    };
+    std::vector<PendingIR> pendingIRs = {};
     for (const auto &entry : program->modules) {
         auto *module = entry.second;
-        auto typeResolver = TypeResolver(program, moduleCompileState);
-        auto generator = IrGenerator(buildEnv, module, functionResolver, typeResolver, log);
-        generator.run();
+        auto &state = moduleCompileState.at(module);
+        PendingIR pendingIR = {
+              .logBuffer = std::make_unique<std::ostringstream>(),
+              .log = std::make_unique<Logger>(log),
+        };
+        pendingIR.log->setOutput(pendingIR.logBuffer.get());
+        auto *moduleLog = pendingIR.log.get();
+        pendingIR.error = modulePool->submit([this, module, &state, &functionResolver, moduleLog]() {
+            if (generateModuleIR(module, functionResolver, *moduleLog)) {
+                return true;
+            }
+            state.bitcode.clear();
+            auto stream = llvm::raw_string_ostream(state.bitcode);
+            llvm::WriteBitcodeToFile(module->llvmModule, stream);
+            stream.flush();
+            return false;
+        });
+        pendingIRs.push_back(std::move(pendingIR));
     }
+
+    // all modules have to be waited for, even if one of them failed, because they are using functionResolver
+    for (auto &pendingIR : pendingIRs) {
+        error |= pendingIR.error.get();
+        log.append(pendingIR.logBuffer->str());
+    }
+    return error;
+}
+
+bool Compiler::generateModuleIR(Module *module, FunctionResolver &functionResolver, const Logger &moduleLog) {
+    // the IR of the previous run is out of date, if the program is compiled again after an edit
+    eraseGeneratedIR(module->llvmModule);
+
+    auto typeResolver = TypeResolver(moduleCompileState, symbolIndex);
+    auto generator = IrGenerator(buildEnv, module, program->symbols, functionResolver, typeResolver, moduleLog);
+    const bool error = generator.run();
+
+    // the AST is only kept around for modules that can still be edited
+    if (!buildEnv->incrementalParsing) {
+        module->ast.clear();
+        moduleCompileState.at(module).nodeToTypeMap = {};
+    }
+    return error;
 }
 
 void Compiler::mergeModules(llvm::Module &destinationModule, const llvm::DataLayout &dataLayout,
                             const std::string &targetTriple) {
     // To be able to link modules, they have to be in the same context.
     // To create modules in parallel, they can't share a context.
-    // One can work around this issue, by writing all the modules into a buffer first and then reading them in again
+    // Modules that have been generated in a context of their own have been written to bitcode, which is read in again
     // with the correct context
 
     for (auto &mod : program->modules) {
-        llvm::Module &llvmModule = mod.second->llvmModule;
-        llvmModule.setDataLayout(dataLayout);
-        llvmModule.setTargetTriple(targetTriple);
+        auto *module = mod.second;
+        std::unique_ptr<llvm::Module> linkedModule = nullptr;
+        if (&module->llvmModule.getContext() == &destinationModule.getContext()) {
+            linkedModule = llvm::CloneModule(module->llvmModule);
+        } else {
+            const auto &bitcode = moduleCompileState.at(module).bitcode;
+            auto result = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, module->getFilePath().string()),
+                                                 destinationModule.getContext());
+            if (!result) {
+                std::cerr << "Could not read the bitcode of module " << module->getFilePath().string() << ": "
+                          << llvm::toString(result.takeError()) << std::endl;
+                exit(1);
+            }
+            linkedModule = std::move(result.get());
+        }
+        linkedModule->setDataLayout(dataLayout);
+        linkedModule->setTargetTriple(targetTriple);
 
-        auto error = llvm::Linker::linkModules(destinationModule, llvm::CloneModule(llvmModule));
+        auto error = llvm::Linker::linkModules(destinationModule, std::move(linkedModule));
         if (error) {
             std::cerr << "Could not link modules" << std::endl;
             exit(1);
@@ -124,6 +427,71 @@ void Compiler::mergeModules(llvm::Module &destinationModule, const llvm::DataLay
     }
 }
 
+void Compiler::linkStdLibBitcode(llvm::Module &module) {
+    if (!buildEnv->linkStdLibBitcode) {
+        return;
+    }
+
+    // the bitcode is only built if a clang matching the llvm version is available, libNeonStd.a is always linked
+    const std::string filePath = buildEnv->buildDirectory + "NeonStd.bc";
+    if (!std::filesystem::exists(filePath)) {
+        LOG_DEBUG(log, "Could not find " + filePath + ", the standard library is only linked as a library");
+        return;
+    }
+
+    auto buffer = llvm::MemoryBuffer::getFile(filePath);
+    if (!buffer) {
+        log.warn("Could not read " + filePath + ": " + buffer.getError().message());
+        return;
+    }
+    auto stdLibModule = llvm::parseBitcodeFile(buffer.get()->getMemBufferRef(), module.getContext());
+    if (!stdLibModule) {
+        log.warn("Could not parse " + filePath + ": " + llvm::toString(stdLibModule.takeError()));
+        return;
+    }
+    stdLibModule.get()->setDataLayout(module.getDataLayout());
+    stdLibModule.get()->setTargetTriple(module.getTargetTriple());
+
+    // only the functions that are actually called are linked in, they are made internal so that they don't clash
+    // with the ones in libNeonStd.a and so that the optimizer can remove them once they have been inlined everywhere
+    auto error = llvm::Linker::linkModules(
+          module, std::move(stdLibModule.get()), llvm::Linker::Flags::LinkOnlyNeeded,
+          [](llvm::Module &linkedModule, const llvm::StringSet<> &linkedNames) {
+              llvm::internalizeModule(linkedModule, [&linkedNames](const llvm::GlobalValue &value) {
+                  return !value.hasName() || linkedNames.count(value.getName()) == 0;
+              });
+          });
+    if (error) {
+        std::cerr << "Could not link the standard library" << std::endl;
+        exit(1);
+    }
+    LOG_DEBUG(log, "Linked " + filePath);
+}
+
+void Compiler::optimizeModule(llvm::Module &module, llvm::TargetMachine *targetMachine) {
+    if (buildEnv->optimizationLevel == OptimizationLevel::O0) {
+        return;
+    }
+
+    // all modules have been linked together at this point, so the pipeline can inline across modules
+    llvm::LoopAnalysisManager loopAnalysisManager = {};
+    llvm::FunctionAnalysisManager functionAnalysisManager = {};
+    llvm::CGSCCAnalysisManager cgsccAnalysisManager = {};
+    llvm::ModuleAnalysisManager moduleAnalysisManager = {};
+    llvm::PassBuilder passBuilder(false, targetMachine);
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager,
+                                     moduleAnalysisManager);
+
+    const auto optimizationLevel = toLlvmOptimizationLevel(buildEnv->optimizationLevel);
+    auto modulePassManager = passBuilder.buildPerModuleDefaultPipeline(optimizationLevel);
+    modulePassManager.run(module, moduleAnalysisManager);
+    LOG_DEBUG(log, "Optimized the program with " + to_string(buildEnv->optimizationLevel));
+}
+
 void Compiler::writeModuleToObjectFile() {
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmParser();
@@ -138,11 +506,22 @@ void Compiler::writeModuleToObjectFile() {
         exit(1);
     }
 
-    const auto *cpu = "generic";
-    const auto *features = "";
+    std::string cpu = buildEnv->targetCpu;
+    std::string features = {};
+    if (cpu == "native") {
+        cpu = llvm::sys::getHostCPUName().str();
+        features = getHostCpuFeatures();
+    }
+    if (!buildEnv->targetFeatures.empty()) {
+        // later features take precedence, so the explicit ones are able to turn off features of the host
+        features += features.empty() ? buildEnv->targetFeatures : "," + buildEnv->targetFeatures;
+    }
+    LOG_DEBUG(log, "Generating code for " + targetTriple + " (cpu: " + cpu + ", features: " + features + ")");
+
     llvm::TargetOptions targetOptions = {};
     auto RM = llvm::Optional<llvm::Reloc::Model>();
-    auto *targetMachine = target->createTargetMachine(targetTriple, cpu, features, targetOptions, RM);
+    auto *targetMachine = target->createTargetMachine(targetTriple, cpu, features, targetOptions, RM, llvm::None,
+                                                      toCodeGenOptLevel(buildEnv->optimizationLevel));
     auto dataLayout = targetMachine->createDataLayout();
 
     auto module = llvm::Module(buildEnv->buildDirectory + program->objectFileName(), program->llvmContext);
@@ -150,11 +529,29 @@ void Compiler::writeModuleToObjectFile() {
     module.setTargetTriple(targetTriple);
 
     mergeModules(module, dataLayout, targetTriple);
+    linkStdLibBitcode(module);
+
+    // the optimizer looks up the subtarget of each function, this also records the selection in the printed IR
+    for (auto &function : module) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+        function.addFnAttr("target-cpu", cpu);
+        // the standard library comes with the features clang selected for it, functions are only inlined into callers
+        // with at least the same features
+        if (features.empty()) {
+            function.removeFnAttr("target-features");
+        } else {
+            function.addFnAttr("target-features", features);
+        }
+    }
 
     if (llvm::verifyModule(module, &llvm::errs())) {
         exit(1);
     }
 
+    optimizeModule(module, targetMachine);
+
     // print llvm ir to console
     if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
         module.print(llvm::outs(), nullptr);
@@ -198,9 +595,19 @@ void Compiler::writeModuleToObjectFile() {
 void Compiler::analyseTypes() {
     for (auto &entry : program->modules) {
         auto &module = entry.second;
-        auto functionResolver = FunctionResolver(program, moduleCompileState);
-        auto result = TypeAnalyzer(log, module, functionResolver).run(module->ast);
-        moduleCompileState[module].nodeToTypeMap = result.first;
-        moduleCompileState[module].nameToTypeMap = result.second;
+        auto functionResolver = FunctionResolver(symbolIndex);
+        auto result = TypeAnalyzer(log, module, functionResolver, program->symbols).run(module->ast);
+        moduleCompileState[module].nodeToTypeMap = std::move(result.first);
+        moduleCompileState[module].nameToTypeMap = std::move(result.second);
+    }
+}
+
+void Compiler::foldConstants() {
+    for (auto &entry : program->modules) {
+        auto *module = entry.second;
+        auto folder = ConstantFolder(program->symbols);
+        folder.run(module->ast);
+        LOG_DEBUG(log, "Folded " + std::to_string(folder.getNumFoldedOperations()) + " operations and removed " +
+                             std::to_string(folder.getNumRemovedBranches()) + " branches in '" + entry.first + "'");
     }
 }
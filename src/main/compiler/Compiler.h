@@ -2,27 +2,78 @@
 
 #include "../BuildEnv.h"
 #include "../Program.h"
+#include "../util/ThreadPool.h"
+#include "FunctionResolver.h"
 #include "MetaTypes.h"
 #include "ModuleCompileState.h"
+#include "SymbolIndex.h"
+
+#include <deque>
+#include <sstream>
+
+namespace llvm {
+class TargetMachine;
+}
 
 class Compiler {
   public:
     Compiler(Program *program, const BuildEnv *buildEnv, const Logger &logger)
         : program(program), buildEnv(buildEnv), log(logger) {}
 
+    /**
+     * Compiles the program into an object file. Modules that have already been loaded are not parsed again, calling
+     * run after updateModule generates the IR of all modules from their edited ASTs.
+     * Returns true, if there was an error.
+     */
     bool run();
 
+    /**
+     * Replaces the bytes [begin, end) of an already loaded module with replacement and only re-parses the top level
+     * statements that are affected by the edit. Requires BuildEnv::incrementalParsing.
+     * Call run afterwards to compile the edited program.
+     * Returns true, if there was an error (the module is left unchanged in that case).
+     */
+    bool updateModule(const std::string &moduleFileName, std::size_t begin, std::size_t end,
+                      std::string_view replacement);
+
+    [[nodiscard]] const SymbolIndex &getSymbolIndex() const { return symbolIndex; }
+
   private:
     Program *program;
     const BuildEnv *buildEnv;
     const Logger &log;
 
+    /// a module that is being parsed, possibly on another thread
+    struct PendingModule {
+        Module *module = nullptr;
+        std::unique_ptr<ModuleCompileState> state = nullptr;
+        /// the messages of modules that are parsed on another thread are buffered and appended to the log in one piece
+        std::unique_ptr<std::ostringstream> logBuffer = nullptr;
+        std::unique_ptr<Logger> log = nullptr;
+        std::future<bool> success = {};
+    };
+
     std::unordered_map<Module *, ModuleCompileState> moduleCompileState = {};
+    /// the declarations that are visible in each module, built once all modules have been parsed
+    SymbolIndex symbolIndex = {};
+    /// lexes the chunks of large modules
+    std::unique_ptr<ThreadPool> threadPool = nullptr;
+    /// parses modules, this can't be threadPool because parsing waits for the lexed chunks
+    std::unique_ptr<ThreadPool> modulePool = nullptr;
 
-    Module *loadModule(const std::string &moduleFileName);
+    void dispatchModule(const std::string &moduleFileName, std::deque<PendingModule> &pendingModules);
+    bool loadModule(Module *module, const Logger &moduleLog, ModuleCompileState &state);
+    bool loadCachedModule(Module *module, const Logger &moduleLog, ModuleCompileState &state);
+    bool parseModule(Module *module, CodeProvider *codeProvider, const Logger &moduleLog, ModuleCompileState &state);
+    void findDeclarations(Module *module, ModuleCompileState &state);
+    void linkStdLibBitcode(llvm::Module &module);
+    void optimizeModule(llvm::Module &module, llvm::TargetMachine *targetMachine);
     void writeModuleToObjectFile();
     void mergeModules(llvm::Module &destinationModule, const llvm::DataLayout &dataLayout,
                       const std::string &targetTriple);
-    void generateIR();
+    /// returns true, if there was an error in any of the modules
+    bool generateIR();
+    bool generateModuleIR(Module *module, FunctionResolver &functionResolver, const Logger &moduleLog);
     void analyseTypes();
+    void foldConstants();
 };
@@ -14,6 +14,13 @@ void Logger::log(const Logger::LogLevel level, const std::string& msg) const {
 
     auto now = std::chrono::system_clock::now();
     auto nowTimeT = std::chrono::system_clock::to_time_t(now);
+    // loggers of different modules are used from different threads, std::localtime is not thread safe
+    std::tm localTime = {};
+#ifdef WIN32
+    localtime_s(&localTime, &nowTimeT);
+#else
+    localtime_r(&nowTimeT, &localTime);
+#endif
 
     std::string levelStr;
     switch (level) {
@@ -52,10 +59,9 @@ void Logger::log(const Logger::LogLevel level, const std::string& msg) const {
         }
     }
 
-    std::cout << colorStr << "[" << std::put_time(std::localtime(&nowTimeT), "%Y-%m-%d %X") << "] - [" << levelStr
-              << "] " << msg;
+    *output << colorStr << "[" << std::put_time(&localTime, "%Y-%m-%d %X") << "] - [" << levelStr << "] " << msg;
     if (colorEnabled) {
-        std::cout << "\u001b[0m";
+        *output << "\u001b[0m";
     }
-    std::cout << "\n";
+    *output << "\n";
 }
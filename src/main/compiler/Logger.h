@@ -5,6 +5,23 @@
 #include <iostream>
 #include <string>
 
+#ifdef NEON_DISABLE_DEBUG_LOG
+#define NEON_DEBUG_LOG_ENABLED false
+#else
+#define NEON_DEBUG_LOG_ENABLED true
+#endif
+
+/**
+ * Only evaluates the message, if it is actually going to be printed.
+ * Compiling with NEON_DISABLE_DEBUG_LOG removes all debug messages from the binary.
+ */
+#define LOG_DEBUG(logger, ...)                                                                                         \
+    do {                                                                                                               \
+        if (NEON_DEBUG_LOG_ENABLED && (logger).isEnabled(Logger::DEBUG_)) {                                            \
+            (logger).debug(__VA_ARGS__);                                                                               \
+        }                                                                                                              \
+    } while (false)
+
 class Logger {
   public:
     enum LogLevel {
@@ -21,15 +38,21 @@ class Logger {
     inline void info(const std::string &msg) const { log(LogLevel::INFO, msg); }
     inline void warn(const std::string &msg) const { log(LogLevel::WARNING, msg); }
     inline void error(const std::string &msg) const { log(LogLevel::ERROR, msg); }
+    /// writes messages that have already been formatted by another logger, e.g. one that has been buffering them
+    inline void append(const std::string &messages) const { *output << messages; }
 
     LogLevel getLogLevel() const { return logLevel; }
+    bool isEnabled(LogLevel level) const { return logLevel <= level; }
     void setLogLevel(LogLevel level) { this->logLevel = level; }
 
     void setColorEnabled(bool enabled) { this->colorEnabled = enabled; }
+    /// the stream has to outlive the logger
+    void setOutput(std::ostream *stream) { this->output = stream; }
 
   private:
     LogLevel logLevel = LogLevel::INFO;
     bool colorEnabled = true;
+    std::ostream *output = &std::cout;
 
     void log(const LogLevel level, const std::string& msg) const;
 };
@@ -3,21 +3,22 @@
 #include <string>
 #include <vector>
 
+#include "SymbolTable.h"
 #include "ast/Types.h"
 
 struct FunctionArgument {
-    std::string name;
+    SymbolId name;
     ast::DataType type;
 };
 
 struct FunctionSignature {
-    std::string name;
+    SymbolId name;
     ast::DataType returnType;
     std::vector<FunctionArgument> arguments = {};
 };
 
 struct ComplexTypeMember {
-    std::string name;
+    SymbolId name;
     ast::DataType type;
 };
 
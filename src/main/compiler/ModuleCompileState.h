@@ -1,9 +1,13 @@
 #pragma once
 
+#include "ast/AstNodeTable.h"
+
 struct ModuleCompileState {
     std::vector<std::string> imports = {};
     std::vector<FunctionSignature> functions = {};
-    std::unordered_map<AstNode*, ast::DataType> nodeToTypeMap;
-    std::unordered_map<std::string, ast::DataType> nameToTypeMap;
+    AstNodeTable<ast::DataType> nodeToTypeMap;
+    std::unordered_map<SymbolId, ast::DataType> nameToTypeMap;
     std::vector<ComplexType> complexTypes;
+    /// the IR of the module, if it has been generated in an LLVMContext of its own (see Compiler::generateIR)
+    std::string bitcode = {};
 };
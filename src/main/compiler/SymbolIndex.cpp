@@ -0,0 +1,45 @@
+#include "SymbolIndex.h"
+
+SymbolIndex::SymbolIndex(Program *program, std::unordered_map<Module *, ModuleCompileState> &moduleCompileState,
+                         const Logger &log) {
+    for (const auto &entry : program->modules) {
+        auto *module = entry.second;
+        const auto &state = moduleCompileState[module];
+        // the first declaration of a name wins, so the module itself has to come first
+        addDeclarations(module, module, state);
+        for (const auto &importedModuleId : state.imports) {
+            auto itr = program->modules.find(importedModuleId);
+            if (itr == program->modules.end()) {
+                log.error("Module '" + importedModuleId + "' imported by '" + entry.first + "' has not been loaded");
+                continue;
+            }
+            auto *importedModule = itr->second;
+            addDeclarations(module, importedModule, moduleCompileState[importedModule]);
+        }
+    }
+}
+
+void SymbolIndex::addDeclarations(Module *module, Module *declaringModule, const ModuleCompileState &state) {
+    for (const auto &function : state.functions) {
+        functions.try_emplace({module, function.name}, FunctionResolveResult{true, &function, declaringModule});
+    }
+    for (const auto &complexType : state.complexTypes) {
+        types.try_emplace({module, complexType.type.id}, TypeResolveResult{true, &complexType, declaringModule});
+    }
+}
+
+FunctionResolveResult SymbolIndex::findFunction(Module *module, SymbolId name) const {
+    auto itr = functions.find({module, name});
+    if (itr == functions.end()) {
+        return {};
+    }
+    return itr->second;
+}
+
+TypeResolveResult SymbolIndex::findType(Module *module, const ast::DataType &type) const {
+    auto itr = types.find({module, type.id});
+    if (itr == types.end()) {
+        return {};
+    }
+    return itr->second;
+}
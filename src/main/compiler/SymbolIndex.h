@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Program.h"
+#include "Logger.h"
+#include "MetaTypes.h"
+#include "ModuleCompileState.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+struct FunctionResolveResult {
+    bool functionExists = false;
+    const FunctionSignature *signature = nullptr;
+    // TODO do we really need this?
+    Module *module = nullptr;
+};
+
+struct TypeResolveResult {
+    bool typeExists = false;
+    const ComplexType *complexType = nullptr;
+    // TODO do we really need this?
+    Module *module = nullptr;
+};
+
+/**
+ * Maps every function and type name that is visible inside a module to its declaration. Declarations of the module
+ * itself take precedence over those of its imports, which are searched in the order of the imports.
+ *
+ * The index is built once all modules have been parsed. It points into the ModuleCompileStates, so it has to be built
+ * again whenever the declarations of a module change.
+ */
+class SymbolIndex {
+  public:
+    SymbolIndex() = default;
+    /// imports of modules that have not been loaded are reported and skipped
+    SymbolIndex(Program *program, std::unordered_map<Module *, ModuleCompileState> &moduleCompileState,
+                const Logger &log);
+
+    [[nodiscard]] FunctionResolveResult findFunction(Module *module, SymbolId name) const;
+    [[nodiscard]] TypeResolveResult findType(Module *module, const ast::DataType &type) const;
+
+  private:
+    /// a name (SymbolId or ast::TypeId) as seen from inside a module
+    struct Key {
+        Module *module;
+        uint32_t name;
+
+        bool operator==(const Key &other) const { return module == other.module && name == other.name; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const {
+            return std::hash<Module *>()(key.module) ^ (std::hash<uint32_t>()(key.name) * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    std::unordered_map<Key, FunctionResolveResult, KeyHash> functions = {};
+    std::unordered_map<Key, TypeResolveResult, KeyHash> types = {};
+
+    void addDeclarations(Module *module, Module *declaringModule, const ModuleCompileState &state);
+};
@@ -0,0 +1,37 @@
+#include "SymbolTable.h"
+
+#include <mutex>
+
+SymbolTable::SymbolTable() { intern(""); }
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto itr = ids.find(name);
+        if (itr != ids.end()) {
+            return itr->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // another thread might have interned the name after we released the shared lock
+    auto itr = ids.find(name);
+    if (itr != ids.end()) {
+        return itr->second;
+    }
+
+    const auto id = static_cast<SymbolId>(names.size());
+    const auto &storedName = names.emplace_back(name);
+    ids.emplace(storedName, id);
+    return id;
+}
+
+const std::string &SymbolTable::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names[id];
+}
+
+std::size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names.size();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// identifies an interned identifier, two identifiers are equal if and only if their SymbolIds are equal
+using SymbolId = uint32_t;
+
+/// the empty name, it is interned by every SymbolTable
+constexpr SymbolId NO_SYMBOL = 0;
+
+/// Interns identifier names and the other strings of the AST (string literals, imports and comments), so that the rest
+/// of the compiler can pass around and compare 32-bit ids instead of strings. Interned names are never removed, which
+/// keeps the ids and the references returned by name() stable.
+/// All methods can be called from several threads at the same time.
+class SymbolTable {
+  public:
+    SymbolTable();
+
+    SymbolId intern(std::string_view name);
+    [[nodiscard]] const std::string &name(SymbolId id) const;
+    [[nodiscard]] std::size_t size() const;
+
+  private:
+    mutable std::shared_mutex mutex;
+    // a deque never moves its elements, the string_view keys of ids point into it
+    std::deque<std::string> names = {};
+    std::unordered_map<std::string_view, SymbolId> ids = {};
+};
@@ -3,30 +3,24 @@
 #include "../Program.h"
 #include "MetaTypes.h"
 #include "ModuleCompileState.h"
+#include "SymbolIndex.h"
 #include "ast/Types.h"
 #include "ast/AstNode.h"
 
 #include <unordered_map>
 
-struct TypeResolveResult {
-    bool typeExists = false;
-    ComplexType complexType = {ast::DataType()};
-    // TODO do we really need this?
-    Module *module = nullptr;
-};
-
 class TypeResolver {
   public:
-    explicit TypeResolver(Program *program, std::unordered_map<Module *, ModuleCompileState> &moduleCompileState)
-        : program(program), moduleCompileState(moduleCompileState) {}
+    explicit TypeResolver(std::unordered_map<Module *, ModuleCompileState> &moduleCompileState,
+                          const SymbolIndex &symbolIndex)
+        : moduleCompileState(moduleCompileState), symbolIndex(symbolIndex) {}
 
-    ast::DataType getTypeOf(Module *module, AstNode* node);
-    ast::DataType getTypeOf(Module *module, const std::string &variableName);
+    const ast::DataType &getTypeOf(Module *module, AstNode *node);
+    ast::DataType getTypeOf(Module *module, SymbolId variableName);
 
     TypeResolveResult resolveType(Module *module, const ast::DataType &type) const;
 
   private:
-    Program *program;
-
     std::unordered_map<Module *, ModuleCompileState> &moduleCompileState;
+    const SymbolIndex &symbolIndex;
 };
@@ -1,27 +1,215 @@
 #include "AST.h"
 
-#include <cassert>
-#include <iostream>
+#include <algorithm>
 #include <utility>
 
-AST::AST() {
-    size_t size = nodeCapacity * sizeof(AstNode);
-    buffer = (AstNode *)std::malloc(size);
+namespace {
+
+void destroyNode(AstNode *node) {
+    // the other nodes only contain ids and pointers into memory that is owned by the tree
+    switch (node->type) {
+    case ast::NodeType::FUNCTION:
+        node->function.~FunctionNode();
+        break;
+    case ast::NodeType::VARIABLE_DEFINITION:
+        node->variable_definition.~VariableDefinitionNode();
+        break;
+    default:
+        break;
+    }
 }
 
-AstNode *AST::root() {
-    // NOTE: the first node in the buffer is assumed to be the root node
-    return buffer;
+} // namespace
+
+AST::AST() { createRoot(); }
+
+AST::~AST() { releaseMemory(); }
+
+void AST::createRoot() {
+    // NOTE: the first node is assumed to be the root node
+    auto *root = allocateNode();
+    root->type = ast::NodeType::SEQUENCE;
+    new (&root->sequence) SequenceNode();
 }
 
-template <typename T> T *AST::createNode(ast::NodeType type) {
-    assert(nextNodeID < nodeCapacity);
-    if (nextNodeID >= nodeCapacity) {
-        std::cerr << "Ran out of space for ast nodes!" << std::endl;
+void AST::releaseMemory() {
+    for (auto &block : blocks) {
+        for (std::size_t i = 0; i < block.size; i++) {
+            destroyNode(block.nodes + i);
+        }
+        ::operator delete(block.nodes);
+    }
+    for (auto &block : spanBlocks) {
+        ::operator delete(block.pointers);
     }
+}
+
+void AST::clear() {
+    releaseMemory();
+    blocks = {};
+    spanBlocks = {};
+    freeNodes = {};
+    freeSpans = {};
+    rootSpanCapacity = 0;
+    numNodes = 0;
+    complete = false;
+    createRoot();
+}
 
-    auto node = buffer + nextNodeID;
-    nextNodeID++;
+AstNode *AST::root() { return blocks.front().nodes; }
+
+template <typename T> void AST::releaseSpan(const AstNodeSpan<T> &span) {
+    if (span.data != nullptr) {
+        freeSpans[span.count].push_back(reinterpret_cast<void **>(span.data));
+    }
+}
+
+void AST::release(AstNode *node) {
+    if (node == nullptr || node == root()) {
+        return;
+    }
+
+    switch (node->type) {
+    case ast::NodeType::SEQUENCE:
+        for (auto *child : node->sequence.children) {
+            release(child);
+        }
+        releaseSpan(node->sequence.children);
+        break;
+    case ast::NodeType::STATEMENT:
+        release(node->statement.child);
+        break;
+    case ast::NodeType::UNARY_OPERATION:
+        release(node->unary_operation.child);
+        break;
+    case ast::NodeType::BINARY_OPERATION:
+        release(node->binary_operation.left);
+        release(node->binary_operation.right);
+        break;
+    case ast::NodeType::FUNCTION:
+        for (auto *argument : node->function.arguments) {
+            release(AST_NODE(argument));
+        }
+        releaseSpan(node->function.arguments);
+        release(node->function.body);
+        break;
+    case ast::NodeType::CALL:
+        for (auto *argument : node->call.arguments) {
+            release(argument);
+        }
+        releaseSpan(node->call.arguments);
+        break;
+    case ast::NodeType::VARIABLE:
+        release(node->variable.arrayIndex);
+        break;
+    case ast::NodeType::ASSIGNMENT:
+        release(node->assignment.left);
+        release(node->assignment.right);
+        break;
+    case ast::NodeType::IF_STATEMENT:
+        release(node->if_statement.condition);
+        release(node->if_statement.ifBody);
+        release(node->if_statement.elseBody);
+        break;
+    case ast::NodeType::FOR_STATEMENT:
+        release(node->for_statement.init);
+        release(node->for_statement.condition);
+        release(node->for_statement.update);
+        release(node->for_statement.body);
+        break;
+    case ast::NodeType::TYPE_DECLARATION:
+        for (auto *member : node->type_declaration.members) {
+            release(AST_NODE(member));
+        }
+        releaseSpan(node->type_declaration.members);
+        break;
+    case ast::NodeType::TYPE_MEMBER:
+        release(AST_NODE(node->type_member.variable_definition));
+        break;
+    case ast::NodeType::MEMBER_ACCESS:
+        release(node->member_access.left);
+        release(node->member_access.right);
+        break;
+    case ast::NodeType::ASSERT:
+        release(node->assert.condition);
+        break;
+    case ast::NodeType::LITERAL:
+    case ast::NodeType::VARIABLE_DEFINITION:
+    case ast::NodeType::IMPORT:
+    case ast::NodeType::COMMENT:
+        break;
+    }
+
+    destroyNode(node);
+    // comments don't own anything, so releaseMemory does not destroy the node a second time
+    node->type = ast::NodeType::COMMENT;
+    freeNodes.push_back(node);
+}
+
+void AST::setRootChildren(const std::vector<AstNode *> &children) {
+    auto &span = root()->sequence.children;
+    // spans that have been created with createSpan are exactly as large as their number of children
+    const auto capacity = std::max(rootSpanCapacity, static_cast<std::size_t>(span.count));
+    if (children.size() > capacity) {
+        if (span.data != nullptr) {
+            freeSpans[capacity].push_back(reinterpret_cast<void **>(span.data));
+        }
+        rootSpanCapacity = std::max(children.size(), capacity * 2);
+        span.data = static_cast<AstNode **>(allocateSpan(rootSpanCapacity));
+    } else {
+        rootSpanCapacity = capacity;
+    }
+    std::copy(children.begin(), children.end(), span.data);
+    span.count = static_cast<uint32_t>(children.size());
+}
+
+AstNode *AST::allocateNode() {
+    if (!freeNodes.empty()) {
+        auto *node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+
+    if (blocks.empty() || blocks.back().size == blocks.back().capacity) {
+        const std::size_t capacity =
+              blocks.empty() ? FIRST_BLOCK_CAPACITY : std::min(blocks.back().capacity * 2, MAX_BLOCK_CAPACITY);
+        auto *nodes = static_cast<AstNode *>(::operator new(capacity * sizeof(AstNode)));
+        blocks.push_back({.nodes = nodes, .capacity = capacity});
+    }
+
+    auto &block = blocks.back();
+    auto *node = block.nodes + block.size;
+    block.size++;
+    node->id = static_cast<AstNodeId>(numNodes);
+    numNodes++;
+    return node;
+}
+
+void *AST::allocateSpan(std::size_t count) {
+    auto itr = freeSpans.find(count);
+    if (itr != freeSpans.end() && !itr->second.empty()) {
+        auto *result = itr->second.back();
+        itr->second.pop_back();
+        return result;
+    }
+
+    if (spanBlocks.empty() || spanBlocks.back().capacity - spanBlocks.back().size < count) {
+        // the rest of the previous block stays unused
+        const std::size_t capacity = std::max(
+              count, spanBlocks.empty() ? FIRST_BLOCK_CAPACITY
+                                        : std::min(spanBlocks.back().capacity * 2, MAX_BLOCK_CAPACITY));
+        auto **pointers = static_cast<void **>(::operator new(capacity * sizeof(void *)));
+        spanBlocks.push_back({.pointers = pointers, .capacity = capacity});
+    }
+
+    auto &block = spanBlocks.back();
+    auto *result = block.pointers + block.size;
+    block.size += count;
+    return result;
+}
+
+template <typename T> T *AST::createNode(ast::NodeType type) {
+    auto node = allocateNode();
     node->type = type;
 
     auto *result = reinterpret_cast<T *>(node);
@@ -63,19 +251,19 @@ UnaryOperationNode *AST::createUnaryOperation(ast::UnaryOperationType type, AstN
     return node;
 }
 
-CallNode *AST::createCall(std::string name, std::vector<AstNode *> parameters) {
+CallNode *AST::createCall(SymbolId name, const std::vector<AstNode *> &parameters) {
     auto node = createNode<CallNode>(ast::NodeType::CALL);
-    node->name = std::move(name);
-    node->arguments = std::move(parameters);
+    node->name = name;
+    node->arguments = createSpan(parameters);
     return node;
 }
 
-FunctionNode *AST::createFunction(std::string name, ast::DataType returnType,
-                                  std::vector<VariableDefinitionNode *> parameters, SequenceNode *body) {
+FunctionNode *AST::createFunction(SymbolId name, ast::DataType returnType,
+                                  const std::vector<VariableDefinitionNode *> &parameters, SequenceNode *body) {
     auto node = createNode<FunctionNode>(ast::NodeType::FUNCTION);
-    node->name = std::move(name);
+    node->name = name;
     node->returnType = std::move(returnType);
-    node->arguments = std::move(parameters);
+    node->arguments = createSpan(parameters);
     node->body = AST_NODE(body);
     return node;
 }
@@ -97,36 +285,36 @@ ForStatementNode *AST::createFor(StatementNode *init, AstNode *condition, Statem
     return node;
 }
 
-CommentNode *AST::createComment(std::string content) {
+CommentNode *AST::createComment(SymbolId content) {
     auto node = createNode<CommentNode>(ast::NodeType::COMMENT);
-    node->content = std::move(content);
+    node->content = content;
     return node;
 }
 
-VariableNode *AST::createVariable(std::string name, AstNode *arrayIndex) {
+VariableNode *AST::createVariable(SymbolId name, AstNode *arrayIndex) {
     auto node = createNode<VariableNode>(ast::NodeType::VARIABLE);
-    node->name = std::move(name);
+    node->name = name;
     node->arrayIndex = arrayIndex;
     return node;
 }
 
-ImportNode *AST::createImport(std::string fileName) {
+ImportNode *AST::createImport(SymbolId fileName) {
     auto node = createNode<ImportNode>(ast::NodeType::IMPORT);
-    node->fileName = std::move(fileName);
+    node->fileName = fileName;
     return node;
 }
 
-VariableDefinitionNode *AST::createVariableDefinition(std::string name, ast::DataType type, int64_t arraySize) {
+VariableDefinitionNode *AST::createVariableDefinition(SymbolId name, ast::DataType type, int64_t arraySize) {
     auto node = createNode<VariableDefinitionNode>(ast::NodeType::VARIABLE_DEFINITION);
-    node->name = std::move(name);
+    node->name = name;
     node->type = std::move(type);
     node->arraySize = arraySize;
     return node;
 }
 
-SequenceNode *AST::createSequence(std::vector<AstNode *> children) {
+SequenceNode *AST::createSequence(const std::vector<AstNode *> &children) {
     auto node = createNode<SequenceNode>(ast::NodeType::SEQUENCE);
-    node->children = std::move(children);
+    node->children = createSpan(children);
     return node;
 }
 
@@ -151,12 +339,10 @@ LiteralNode *AST::createLiteralInteger(int64_t value) {
     return node;
 }
 
-LiteralNode *AST::createLiteralString(std::string value) {
+LiteralNode *AST::createLiteralString(SymbolId value) {
     auto node = createNode<LiteralNode>(ast::NodeType::LITERAL);
     node->type = LiteralType::STRING;
-    // NOTE we have to do this, in order for std::string to be initialized correctly
-    new (&node->s) std::string;
-    node->s = std::move(value);
+    node->s = value;
     return node;
 }
 
@@ -173,10 +359,10 @@ TypeMemberNode *AST::createTypeMember(VariableDefinitionNode *inner) {
     return node;
 }
 
-TypeDeclarationNode *AST::createTypeDeclaration(std::string name, std::vector<TypeMemberNode *> members) {
+TypeDeclarationNode *AST::createTypeDeclaration(SymbolId name, const std::vector<TypeMemberNode *> &members) {
     auto node = createNode<TypeDeclarationNode>(ast::NodeType::TYPE_DECLARATION);
-    node->name = std::move(name);
-    node->members = std::move(members);
+    node->name = name;
+    node->members = createSpan(members);
     return node;
 }
 
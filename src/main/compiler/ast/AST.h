@@ -2,33 +2,70 @@
 
 #include "AstNode.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 class AST {
-    AstNode *buffer = nullptr;
-    int64_t nextNodeID = 1;
-    uint64_t nodeCapacity = 1000000;
+    /// a fixed size piece of memory for nodes, blocks are never moved or resized so that pointers to nodes stay valid
+    struct Block {
+        AstNode *nodes = nullptr;
+        std::size_t capacity = 0;
+        std::size_t size = 0;
+    };
+
+    /// memory for the pointers of child lists, filled from front to back like the node blocks
+    struct SpanBlock {
+        void **pointers = nullptr;
+        std::size_t capacity = 0;
+        std::size_t size = 0;
+    };
+
+    static constexpr std::size_t FIRST_BLOCK_CAPACITY = 256;
+    static constexpr std::size_t MAX_BLOCK_CAPACITY = 65536;
+
+    std::vector<Block> blocks = {};
+    std::vector<SpanBlock> spanBlocks = {};
+    /// released nodes are handed out again before the blocks grow, they keep their ids
+    std::vector<AstNode *> freeNodes = {};
+    /// released spans by their size, they are only handed out again for spans of the same size
+    std::unordered_map<std::size_t, std::vector<void **>> freeSpans = {};
+    /// the children of the root can be replaced with setRootChildren, which grows their span geometrically
+    std::size_t rootSpanCapacity = 0;
+    std::size_t numNodes = 0;
     bool complete = false;
 
   public:
     AST();
+    ~AST();
+
+    AST(const AST &) = delete;
+    AST &operator=(const AST &) = delete;
 
     AstNode *root();
     void completed();
+    /// frees all nodes, afterwards the tree is incomplete and only contains an empty root (node ids start at 0 again)
+    void clear();
+    /// returns the memory of the node and all of its descendants to the tree, they must not be used anymore afterwards
+    void release(AstNode *node);
+    /// replaces the children of the root, their previous span is reused if it is large enough
+    void setRootChildren(const std::vector<AstNode *> &children);
 
     StatementNode *createStatement(AstNode *child, bool isReturn);
     AssertNode *createAssert(AstNode *condition);
     AssignmentNode *createAssignment(AstNode *left, AstNode *right);
     BinaryOperationNode *createBinaryOperation(ast::BinaryOperationType type, AstNode *left, AstNode *right);
     UnaryOperationNode *createUnaryOperation(ast::UnaryOperationType type, AstNode *child);
-    CallNode *createCall(std::string name, std::vector<AstNode *> parameters);
-    FunctionNode *createFunction(std::string name, ast::DataType returnType,
-                                 std::vector<VariableDefinitionNode *> parameters, SequenceNode *body);
+    CallNode *createCall(SymbolId name, const std::vector<AstNode *> &parameters);
+    FunctionNode *createFunction(SymbolId name, ast::DataType returnType,
+                                 const std::vector<VariableDefinitionNode *> &parameters, SequenceNode *body);
     IfStatementNode *createIf(AstNode *condition, SequenceNode *ifBody, SequenceNode *elseBody);
     ForStatementNode *createFor(StatementNode *init, AstNode *condition, StatementNode *update, SequenceNode *body);
-    CommentNode *createComment(std::string content);
-    VariableNode *createVariable(std::string name, AstNode *arrayIndex);
-    ImportNode *createImport(std::string fileName);
-    VariableDefinitionNode *createVariableDefinition(std::string name, ast::DataType type, int64_t arraySize);
-    SequenceNode *createSequence(std::vector<AstNode *> children);
+    CommentNode *createComment(SymbolId content);
+    VariableNode *createVariable(SymbolId name, AstNode *arrayIndex);
+    ImportNode *createImport(SymbolId fileName);
+    VariableDefinitionNode *createVariableDefinition(SymbolId name, ast::DataType type, int64_t arraySize);
+    SequenceNode *createSequence(const std::vector<AstNode *> &children);
     MemberAccessNode *createMemberAccess(AstNode *left, AstNode *right);
 
     LiteralNode *createLiteralInteger(int64_t value);
@@ -37,14 +74,32 @@ class AST {
 
     LiteralNode *createLiteralBool(bool value);
 
-    LiteralNode *createLiteralString(std::string value);
+    LiteralNode *createLiteralString(SymbolId value);
 
     TypeMemberNode *createTypeMember(VariableDefinitionNode *inner);
 
-    TypeDeclarationNode *createTypeDeclaration(std::string name, std::vector<TypeMemberNode *> members);
+    TypeDeclarationNode *createTypeDeclaration(SymbolId name, const std::vector<TypeMemberNode *> &members);
+
+    /// copies the given nodes into memory owned by this tree
+    template <typename T> AstNodeSpan<T> createSpan(const std::vector<T *> &nodes) {
+        if (nodes.empty()) {
+            return {};
+        }
+        auto **data = static_cast<T **>(allocateSpan(nodes.size()));
+        std::copy(nodes.begin(), nodes.end(), data);
+        return {.data = data, .count = static_cast<uint32_t>(nodes.size())};
+    }
 
     bool is_complete() const;
 
+    /// number of nodes in the tree, including the root node
+    [[nodiscard]] std::size_t size() const { return numNodes; }
+
   private:
+    void createRoot();
+    void releaseMemory();
+    AstNode *allocateNode();
+    void *allocateSpan(std::size_t count);
+    template <typename T> void releaseSpan(const AstNodeSpan<T> &span);
     template <typename T> T *createNode(ast::NodeType type);
 };
@@ -1,15 +1,34 @@
 #pragma once
 
+#include "../SymbolTable.h"
 #include "Types.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #define AST_NODE(n) reinterpret_cast<AstNode *>(n)
 
 struct AstNode;
-typedef int64_t AstNodeID;
+
+/// identifies a node within its AST, ids are handed out densely in the order the nodes are created, starting at 0
+using AstNodeId = uint32_t;
+
 enum class LiteralType { BOOL, INTEGER, FLOAT, STRING };
 
+/// A list of child nodes that lives in a contiguous piece of memory owned by the AST (see AST::createSpan).
+/// Spans are never resized, to change the children of a node a new span has to be created.
+template <typename T> struct AstNodeSpan {
+    T **data = nullptr;
+    uint32_t count = 0;
+
+    [[nodiscard]] T **begin() const { return data; }
+    [[nodiscard]] T **end() const { return data + count; }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] T *back() const { return data[count - 1]; }
+    T *operator[](std::size_t idx) const { return data[idx]; }
+};
+
 struct AssertNode {
     AstNode *condition = nullptr;
 };
@@ -28,12 +47,12 @@ struct BinaryOperationNode {
 };
 
 struct CallNode {
-    std::string name;
-    std::vector<AstNode *> arguments = {};
+    SymbolId name;
+    AstNodeSpan<AstNode> arguments = {};
 };
 
 struct CommentNode {
-    std::string content;
+    SymbolId content;
 };
 
 struct ForStatementNode {
@@ -45,10 +64,10 @@ struct ForStatementNode {
 
 struct VariableDefinitionNode;
 struct FunctionNode {
-    std::string name;
+    SymbolId name;
     ast::DataType returnType;
     AstNode *body = nullptr;
-    std::vector<VariableDefinitionNode *> arguments = {};
+    AstNodeSpan<VariableDefinitionNode> arguments = {};
 
     [[nodiscard]] bool is_external() const { return body == nullptr; }
 };
@@ -60,7 +79,7 @@ struct IfStatementNode {
 };
 
 struct ImportNode {
-    std::string fileName;
+    SymbolId fileName;
 };
 
 struct LiteralNode {
@@ -71,7 +90,7 @@ struct LiteralNode {
         bool b;
         int64_t i;
         double d;
-        std::string s;
+        SymbolId s;
     };
 };
 
@@ -84,7 +103,7 @@ struct MemberAccessNode {
 };
 
 struct SequenceNode {
-    std::vector<AstNode *> children;
+    AstNodeSpan<AstNode> children = {};
 };
 
 struct StatementNode {
@@ -97,10 +116,8 @@ struct TypeMemberNode {
 };
 
 struct TypeDeclarationNode {
-    std::string name;
-    std::vector<TypeMemberNode *> members = {};
-
-    [[nodiscard]] ast::DataType type() const { return ast::DataType(name); }
+    SymbolId name;
+    AstNodeSpan<TypeMemberNode> members = {};
 };
 
 struct UnaryOperationNode {
@@ -109,19 +126,25 @@ struct UnaryOperationNode {
 };
 
 struct VariableDefinitionNode {
-    std::string name;
+    SymbolId name;
     ast::DataType type;
     int64_t arraySize;
     bool is_array() const;
 };
 
 struct VariableNode {
-    std::string name;
+    SymbolId name;
     AstNode *arrayIndex = nullptr;
 
     [[nodiscard]] bool is_array_access() const;
 };
 
+/**
+ * The nodes are stored array-of-structs in the block arena of their AST: the payload of every kind shares one union,
+ * children are referenced by pointer and the node type is stored in the node itself rather than in a separate tag
+ * array. Every pass walks the tree through AstNode pointers without access to the AST that owns the nodes, which
+ * index-based children would require. Data that does not fit into a node lives in AstNodeTables indexed by the id.
+ */
 struct AstNode {
 
     AstNode() {}
@@ -149,6 +172,7 @@ struct AstNode {
     };
 
     ast::NodeType type;
+    AstNodeId id;
 };
 
 std::string to_string(ast::NodeType type);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "AstNode.h"
+
+#include <cassert>
+#include <vector>
+
+/**
+ * Associates a value with the nodes of one AST, indexed by the id of the node. Ids are dense, so a lookup is a single
+ * array access. Nodes that have not been assigned a value map to a default constructed value.
+ */
+template <typename T> class AstNodeTable {
+    std::vector<T> values = {};
+
+  public:
+    AstNodeTable() = default;
+    /// makes room for the nodes of a tree of the given size (AST::size())
+    explicit AstNodeTable(std::size_t numNodes) : values(numNodes) {}
+
+    /// the table never grows, so that references into it stay valid (e.g. in table[a] = table[b])
+    T &operator[](const AstNode *node) {
+        assert(node->id < values.size() && "the table has been created for a smaller tree");
+        return values[node->id];
+    }
+
+    const T &get(const AstNode *node) const {
+        static const T defaultValue{};
+        if (node->id >= values.size()) {
+            return defaultValue;
+        }
+        return values[node->id];
+    }
+};
@@ -1,8 +1,76 @@
 #include "Types.h"
 
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
-std::string to_string(const ast::DataType &dataType) { return dataType.typeName; }
+namespace {
+
+/// interns the names of all types, works just like the SymbolTable
+class TypeTable {
+  public:
+    TypeTable() { reset(); }
+
+    void reset() {
+        std::unique_lock lock(mutex);
+        ids.clear();
+        names.clear();
+        // the simple data types come first, so that their handles are the values of SimpleDataType
+        for (auto simple : {ast::VOID, ast::BOOLEAN, ast::INTEGER, ast::FLOAT, ast::STRING}) {
+            names.emplace_back(to_string(simple));
+            ids.emplace(names.back(), static_cast<ast::TypeId>(simple));
+        }
+    }
+
+    ast::TypeId intern(std::string_view name) {
+        {
+            std::shared_lock lock(mutex);
+            auto itr = ids.find(name);
+            if (itr != ids.end()) {
+                return itr->second;
+            }
+        }
+
+        std::unique_lock lock(mutex);
+        // another thread might have interned the name in the meantime
+        auto itr = ids.find(name);
+        if (itr != ids.end()) {
+            return itr->second;
+        }
+        const auto id = static_cast<ast::TypeId>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    const std::string &name(ast::TypeId id) {
+        std::shared_lock lock(mutex);
+        return names[id];
+    }
+
+  private:
+    std::shared_mutex mutex;
+    // a deque never moves its elements, the string_view keys of ids point into it
+    std::deque<std::string> names = {};
+    std::unordered_map<std::string_view, ast::TypeId> ids = {};
+};
+
+TypeTable &typeTable() {
+    static TypeTable table = {};
+    return table;
+}
+
+} // namespace
+
+ast::DataType::DataType(std::string_view typeName) : id(typeTable().intern(typeName)) {}
+
+const std::string &ast::DataType::name() const { return typeTable().name(id); }
+
+void ast::resetTypes() { typeTable().reset(); }
+
+std::string to_string(const ast::DataType &dataType) { return dataType.name(); }
 
 std::string to_string(ast::SimpleDataType type) {
     switch (type) {
@@ -82,26 +150,11 @@ ast::SimpleDataType from_string(const std::string &type) {
     exit(1);
 }
 
-bool ast::isSimpleDataType(const ast::DataType &type) {
-    return type.typeName == "VOID" || type.typeName == "BOOL" || type.typeName == "INT" || type.typeName == "FLOAT" ||
-           type.typeName == "STRING";
-}
+bool ast::isSimpleDataType(const ast::DataType &type) { return type.id <= ast::SimpleDataType::STRING; }
 
 ast::SimpleDataType ast::toSimpleDataType(const ast::DataType &type) {
-    if (type.typeName == "VOID") {
+    if (!isSimpleDataType(type)) {
         return ast::SimpleDataType::VOID;
     }
-    if (type.typeName == "BOOL") {
-        return ast::SimpleDataType::BOOLEAN;
-    }
-    if (type.typeName == "INT") {
-        return ast::SimpleDataType::INTEGER;
-    }
-    if (type.typeName == "FLOAT") {
-        return ast::SimpleDataType::FLOAT;
-    }
-    if (type.typeName == "STRING") {
-        return ast::SimpleDataType::STRING;
-    }
-    return ast::SimpleDataType::VOID;
+    return static_cast<ast::SimpleDataType>(type.id);
 }
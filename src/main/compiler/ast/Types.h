@@ -1,26 +1,39 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <utility>
+#include <string_view>
 
 namespace ast {
 enum SimpleDataType { VOID, BOOLEAN, INTEGER, FLOAT, STRING };
-}
+
+/// handle of an interned type name, the simple data types have the values of SimpleDataType as their handles
+using TypeId = uint32_t;
+} // namespace ast
 
 std::string to_string(ast::SimpleDataType type);
 ast::SimpleDataType from_string(const std::string &type);
 
 namespace ast {
 
+/**
+ * A type, represented by a handle into a type table that is shared by the whole process. Two types are equal if and
+ * only if their handles are equal, and creating one of the simple data types does not touch the table at all.
+ * The handles are not stable across processes (or across resetTypes()), anything that is written to disk has to use
+ * name() instead.
+ */
 struct DataType {
-    std::string typeName;
-    explicit DataType() : typeName(to_string(SimpleDataType::VOID)) {}
-    explicit DataType(SimpleDataType simple) : typeName(to_string(simple)) {}
-    explicit DataType(std::string typeName) : typeName(std::move(typeName)) {}
+    TypeId id;
+    explicit DataType() : id(SimpleDataType::VOID) {}
+    explicit DataType(SimpleDataType simple) : id(simple) {}
+    /// interns typeName, the names of the simple data types ("INT", ...) resolve to their handles
+    explicit DataType(std::string_view typeName);
+
+    [[nodiscard]] const std::string &name() const;
 };
 
-inline bool operator==(const DataType &lhs, const DataType &rhs) { return lhs.typeName == rhs.typeName; }
-inline bool operator!=(const DataType &lhs, const DataType &rhs) { return lhs.typeName != rhs.typeName; }
+inline bool operator==(const DataType &lhs, const DataType &rhs) { return lhs.id == rhs.id; }
+inline bool operator!=(const DataType &lhs, const DataType &rhs) { return lhs.id != rhs.id; }
 
 enum class NodeType {
     SEQUENCE,
@@ -63,6 +76,13 @@ enum class UnaryOperationType {
     NEGATE,
 };
 
+/**
+ * Forgets all interned type names except the ones of the simple data types, so that the table does not keep growing in
+ * long-lived processes. Every DataType that is not a simple data type becomes invalid, the CompileSession calls this
+ * once no program is left that could still refer to one.
+ */
+void resetTypes();
+
 bool isSimpleDataType(const ast::DataType &type);
 
 SimpleDataType toSimpleDataType(const ast::DataType &type);
@@ -77,7 +97,7 @@ std::string to_string(ast::UnaryOperationType operationType);
 namespace std {
 
 template <> struct hash<ast::DataType> {
-    std::size_t operator()(const ast::DataType &k) const { return hash<string>()(k.typeName); }
+    std::size_t operator()(const ast::DataType &k) const { return hash<ast::TypeId>()(k.id); }
 };
 
 } // namespace std
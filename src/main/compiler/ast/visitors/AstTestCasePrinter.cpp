@@ -3,7 +3,7 @@
 #include "util/Utils.h"
 
 #if 0
-void AstTestCasePrinter::printNode(AstNodeID node) const {
+void AstTestCasePrinter::printNode(AstNode *node) const {
     std::cout << "        {" << indentation << ", " << to_string(node->getAstNodeType()) << "}," << std::endl;
 }
 
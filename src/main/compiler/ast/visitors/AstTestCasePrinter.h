@@ -13,7 +13,7 @@ class AstTestCasePrinter {
     void run();
 
   private:
-    void printNode(AstNodeID node) const;
+    void printNode(AstNode *node) const;
 
     void visitNode(AstNode *node);
     void visitAssignmentNode(AssignmentNode *node);
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../AST.h"
+#include "../AstNode.h"
+
+/**
+ * Base class for passes over the AST (CRTP). visitNode calls the visit method for the type of the node on Derived, so
+ * the dispatch is resolved at compile time.
+ *
+ * A pass only defines the visit methods for the kinds of nodes it cares about, all other nodes are ignored. Passes
+ * that keep their visit methods private have to declare AstVisitor<Derived> as a friend.
+ */
+template <typename Derived> class AstVisitor {
+  public:
+    void visitNode(AstNode *node) {
+        auto *self = static_cast<Derived *>(this);
+        switch (node->type) {
+        case ast::NodeType::SEQUENCE:
+            self->visitSequenceNode(&node->sequence);
+            break;
+        case ast::NodeType::STATEMENT:
+            self->visitStatementNode(&node->statement);
+            break;
+        case ast::NodeType::LITERAL:
+            self->visitLiteralNode(&node->literal);
+            break;
+        case ast::NodeType::UNARY_OPERATION:
+            self->visitUnaryOperationNode(&node->unary_operation);
+            break;
+        case ast::NodeType::BINARY_OPERATION:
+            self->visitBinaryOperationNode(&node->binary_operation);
+            break;
+        case ast::NodeType::FUNCTION:
+            self->visitFunctionNode(&node->function);
+            break;
+        case ast::NodeType::CALL:
+            self->visitCallNode(&node->call);
+            break;
+        case ast::NodeType::VARIABLE_DEFINITION:
+            self->visitVariableDefinitionNode(&node->variable_definition);
+            break;
+        case ast::NodeType::VARIABLE:
+            self->visitVariableNode(&node->variable);
+            break;
+        case ast::NodeType::ASSIGNMENT:
+            self->visitAssignmentNode(&node->assignment);
+            break;
+        case ast::NodeType::IF_STATEMENT:
+            self->visitIfStatementNode(&node->if_statement);
+            break;
+        case ast::NodeType::FOR_STATEMENT:
+            self->visitForStatementNode(&node->for_statement);
+            break;
+        case ast::NodeType::IMPORT:
+            self->visitImportNode(&node->import);
+            break;
+        case ast::NodeType::TYPE_DECLARATION:
+            self->visitTypeDeclarationNode(&node->type_declaration);
+            break;
+        case ast::NodeType::TYPE_MEMBER:
+            self->visitTypeMemberNode(&node->type_member);
+            break;
+        case ast::NodeType::MEMBER_ACCESS:
+            self->visitMemberAccessNode(&node->member_access);
+            break;
+        case ast::NodeType::ASSERT:
+            self->visitAssertNode(&node->assert);
+            break;
+        case ast::NodeType::COMMENT:
+            self->visitCommentNode(&node->comment);
+            break;
+        }
+    }
+
+  protected:
+    void visitAssertNode(AssertNode * /*node*/) {}
+    void visitAssignmentNode(AssignmentNode * /*node*/) {}
+    void visitBinaryOperationNode(BinaryOperationNode * /*node*/) {}
+    void visitCallNode(CallNode * /*node*/) {}
+    void visitCommentNode(CommentNode * /*node*/) {}
+    void visitForStatementNode(ForStatementNode * /*node*/) {}
+    void visitFunctionNode(FunctionNode * /*node*/) {}
+    void visitIfStatementNode(IfStatementNode * /*node*/) {}
+    void visitImportNode(ImportNode * /*node*/) {}
+    void visitLiteralNode(LiteralNode * /*node*/) {}
+    void visitMemberAccessNode(MemberAccessNode * /*node*/) {}
+    void visitSequenceNode(SequenceNode * /*node*/) {}
+    void visitStatementNode(StatementNode * /*node*/) {}
+    void visitTypeDeclarationNode(TypeDeclarationNode * /*node*/) {}
+    void visitTypeMemberNode(TypeMemberNode * /*node*/) {}
+    void visitUnaryOperationNode(UnaryOperationNode * /*node*/) {}
+    void visitVariableDefinitionNode(VariableDefinitionNode * /*node*/) {}
+    void visitVariableNode(VariableNode * /*node*/) {}
+};
+
+/**
+ * Hands every declaration of a module (the nodes at the top level, below the root sequence and its statements) to all
+ * of the given passes, so that any number of passes only needs a single walk over the module.
+ */
+template <typename... Passes> void visitDeclarations(AstNode *node, Passes &...passes) {
+    switch (node->type) {
+    case ast::NodeType::SEQUENCE:
+        for (auto *child : node->sequence.children) {
+            visitDeclarations(child, passes...);
+        }
+        break;
+    case ast::NodeType::STATEMENT:
+        visitDeclarations(node->statement.child, passes...);
+        break;
+    default:
+        (passes.visitNode(node), ...);
+        break;
+    }
+}
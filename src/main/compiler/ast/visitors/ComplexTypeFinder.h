@@ -5,16 +5,22 @@
 #include "../../MetaTypes.h"
 #include "../AST.h"
 #include "../AstNode.h"
+#include "AstVisitor.h"
 
-class ComplexTypeFinder {
+class ComplexTypeFinder : public AstVisitor<ComplexTypeFinder> {
+    friend class AstVisitor<ComplexTypeFinder>;
+
+    const SymbolTable &symbols;
     std::vector<ComplexType> types = {};
 
   public:
+    explicit ComplexTypeFinder(const SymbolTable &symbols) : symbols(symbols) {}
+
     std::vector<ComplexType> run(AST &tree);
 
+    /// the types that have been found so far, for use with visitDeclarations
+    std::vector<ComplexType> &getTypes() { return types; }
+
   private:
-    void visitNode(AstNode *node);
-    void visitSequenceNode(AstNode *node);
-    void visitStatementNode(AstNode *node);
-    void visitTypeDeclarationNode(AstNode *node);
+    void visitTypeDeclarationNode(TypeDeclarationNode *node);
 };
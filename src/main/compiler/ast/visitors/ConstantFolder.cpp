@@ -0,0 +1,230 @@
+#include "ConstantFolder.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+bool isLiteral(const AstNode *node, LiteralType type) {
+    return node != nullptr && node->type == ast::NodeType::LITERAL && node->literal.type == type;
+}
+
+/// integer operations wrap around on overflow, just like the instructions the IrGenerator emits for them
+int64_t wrap(uint64_t value) { return static_cast<int64_t>(value); }
+
+} // namespace
+
+void ConstantFolder::run(AST &ast) {
+    tree = &ast;
+    visitNode(tree->root());
+}
+
+void ConstantFolder::visitChild(AstNode *node) {
+    if (node != nullptr) {
+        visitNode(node);
+    }
+}
+
+LiteralNode *ConstantFolder::replaceWithLiteral(AstNode *node, LiteralType type) {
+    // only operations are replaced, they don't own anything that would have to be destroyed first
+    if (node->type == ast::NodeType::BINARY_OPERATION) {
+        tree->release(node->binary_operation.left);
+        tree->release(node->binary_operation.right);
+    } else if (node->type == ast::NodeType::UNARY_OPERATION) {
+        tree->release(node->unary_operation.child);
+    }
+    node->type = ast::NodeType::LITERAL;
+    auto *result = new (&node->literal) LiteralNode();
+    result->type = type;
+    numFoldedOperations++;
+    return result;
+}
+
+void ConstantFolder::visitAssertNode(AssertNode *node) {
+    // the message of a failed assert shows both sides of a comparison, so the comparison itself has to stay
+    if (node->condition->type == ast::NodeType::BINARY_OPERATION) {
+        visitChild(node->condition->binary_operation.left);
+        visitChild(node->condition->binary_operation.right);
+    }
+}
+
+void ConstantFolder::visitAssignmentNode(AssignmentNode *node) {
+    visitChild(node->left);
+    visitChild(node->right);
+}
+
+void ConstantFolder::visitBinaryOperationNode(BinaryOperationNode *node) {
+    visitChild(node->left);
+    visitChild(node->right);
+
+    auto *left = node->left;
+    auto *right = node->right;
+    if (isLiteral(left, LiteralType::INTEGER) && isLiteral(right, LiteralType::INTEGER)) {
+        foldIntegerOperation(node, left->literal.i, right->literal.i);
+    } else if (isLiteral(left, LiteralType::FLOAT) && isLiteral(right, LiteralType::FLOAT)) {
+        foldFloatOperation(node, left->literal.d, right->literal.d);
+    } else if (isLiteral(left, LiteralType::BOOL) && isLiteral(right, LiteralType::BOOL)) {
+        // both sides are always evaluated, so this can only be folded if both of them are constant
+        const bool l = left->literal.b;
+        const bool r = right->literal.b;
+        if (node->type == ast::BinaryOperationType::AND) {
+            replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = l && r;
+        } else if (node->type == ast::BinaryOperationType::OR) {
+            replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = l || r;
+        }
+    } else if (isLiteral(left, LiteralType::STRING) && isLiteral(right, LiteralType::STRING) &&
+               node->type == ast::BinaryOperationType::ADDITION) {
+        const auto value = symbols.intern(symbols.name(left->literal.s) + symbols.name(right->literal.s));
+        replaceWithLiteral(AST_NODE(node), LiteralType::STRING)->s = value;
+    }
+}
+
+bool ConstantFolder::foldIntegerOperation(BinaryOperationNode *node, int64_t left, int64_t right) {
+    const auto l = static_cast<uint64_t>(left);
+    const auto r = static_cast<uint64_t>(right);
+    switch (node->type) {
+    case ast::BinaryOperationType::ADDITION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::INTEGER)->i = wrap(l + r);
+        return true;
+    case ast::BinaryOperationType::SUBTRACTION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::INTEGER)->i = wrap(l - r);
+        return true;
+    case ast::BinaryOperationType::MULTIPLICATION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::INTEGER)->i = wrap(l * r);
+        return true;
+    case ast::BinaryOperationType::DIVISION:
+        if (right == 0 || (left == std::numeric_limits<int64_t>::min() && right == -1)) {
+            // undefined, the division is left for the program to run into
+            return false;
+        }
+        replaceWithLiteral(AST_NODE(node), LiteralType::INTEGER)->i = left / right;
+        return true;
+    case ast::BinaryOperationType::EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left == right;
+        return true;
+    case ast::BinaryOperationType::NOT_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left != right;
+        return true;
+    case ast::BinaryOperationType::LESS_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left <= right;
+        return true;
+    case ast::BinaryOperationType::LESS_THAN:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left < right;
+        return true;
+    case ast::BinaryOperationType::GREATER_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left >= right;
+        return true;
+    case ast::BinaryOperationType::GREATER_THAN:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left > right;
+        return true;
+    case ast::BinaryOperationType::AND:
+    case ast::BinaryOperationType::OR:
+        return false;
+    }
+    return false;
+}
+
+bool ConstantFolder::foldFloatOperation(BinaryOperationNode *node, double left, double right) {
+    // the comparisons are ordered, i.e. they are all false if one of the operands is NaN
+    const bool ordered = !std::isnan(left) && !std::isnan(right);
+    switch (node->type) {
+    case ast::BinaryOperationType::ADDITION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::FLOAT)->d = left + right;
+        return true;
+    case ast::BinaryOperationType::SUBTRACTION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::FLOAT)->d = left - right;
+        return true;
+    case ast::BinaryOperationType::MULTIPLICATION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::FLOAT)->d = left * right;
+        return true;
+    case ast::BinaryOperationType::DIVISION:
+        replaceWithLiteral(AST_NODE(node), LiteralType::FLOAT)->d = left / right;
+        return true;
+    case ast::BinaryOperationType::EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = ordered && left == right;
+        return true;
+    case ast::BinaryOperationType::NOT_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = ordered && left != right;
+        return true;
+    case ast::BinaryOperationType::LESS_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left <= right;
+        return true;
+    case ast::BinaryOperationType::LESS_THAN:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left < right;
+        return true;
+    case ast::BinaryOperationType::GREATER_EQUALS:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left >= right;
+        return true;
+    case ast::BinaryOperationType::GREATER_THAN:
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = left > right;
+        return true;
+    case ast::BinaryOperationType::AND:
+    case ast::BinaryOperationType::OR:
+        return false;
+    }
+    return false;
+}
+
+void ConstantFolder::visitUnaryOperationNode(UnaryOperationNode *node) {
+    visitChild(node->child);
+
+    auto *child = node->child;
+    if (node->type == ast::UnaryOperationType::NOT && isLiteral(child, LiteralType::BOOL)) {
+        const bool value = child->literal.b;
+        replaceWithLiteral(AST_NODE(node), LiteralType::BOOL)->b = !value;
+    } else if (node->type == ast::UnaryOperationType::NEGATE && isLiteral(child, LiteralType::INTEGER)) {
+        const auto value = static_cast<uint64_t>(child->literal.i);
+        replaceWithLiteral(AST_NODE(node), LiteralType::INTEGER)->i = wrap(0 - value);
+    } else if (node->type == ast::UnaryOperationType::NEGATE && isLiteral(child, LiteralType::FLOAT)) {
+        const double value = child->literal.d;
+        replaceWithLiteral(AST_NODE(node), LiteralType::FLOAT)->d = -value;
+    }
+}
+
+void ConstantFolder::visitCallNode(CallNode *node) {
+    for (auto *argument : node->arguments) {
+        visitChild(argument);
+    }
+}
+
+void ConstantFolder::visitForStatementNode(ForStatementNode *node) {
+    visitChild(node->init);
+    visitChild(node->condition);
+    visitChild(node->update);
+    visitChild(node->body);
+}
+
+void ConstantFolder::visitFunctionNode(FunctionNode *node) { visitChild(node->body); }
+
+void ConstantFolder::visitIfStatementNode(IfStatementNode *node) {
+    visitChild(node->condition);
+    visitChild(node->ifBody);
+    visitChild(node->elseBody);
+
+    if (!isLiteral(node->condition, LiteralType::BOOL)) {
+        return;
+    }
+
+    // the IrGenerator only emits the remaining body for a constant condition
+    auto &deadBody = node->condition->literal.b ? node->elseBody : node->ifBody;
+    if (deadBody != nullptr) {
+        tree->release(deadBody);
+        deadBody = nullptr;
+        numRemovedBranches++;
+    }
+}
+
+void ConstantFolder::visitMemberAccessNode(MemberAccessNode *node) {
+    visitChild(node->left);
+    visitChild(node->right);
+}
+
+void ConstantFolder::visitSequenceNode(SequenceNode *node) {
+    for (auto *child : node->children) {
+        visitChild(child);
+    }
+}
+
+void ConstantFolder::visitStatementNode(StatementNode *node) { visitChild(node->child); }
+
+void ConstantFolder::visitVariableNode(VariableNode *node) { visitChild(node->arrayIndex); }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../../SymbolTable.h"
+#include "../AST.h"
+#include "../AstNode.h"
+#include "AstVisitor.h"
+
+#include <cstddef>
+
+/**
+ * Evaluates operations on literals at compile time and removes the branches of if statements that can never be taken.
+ *
+ * Folded operations are turned into literals in place, so that pointers to them and their entries in the type map of
+ * the TypeAnalyzer stay valid. Only operations that the IrGenerator supports for the types of their operands are
+ * folded, everything else is left alone so that it is still reported as an error. The operands of folded operations
+ * and the removed branches are released back to the tree.
+ */
+class ConstantFolder : public AstVisitor<ConstantFolder> {
+    friend class AstVisitor<ConstantFolder>;
+
+    SymbolTable &symbols;
+    AST *tree = nullptr;
+    std::size_t numFoldedOperations = 0;
+    std::size_t numRemovedBranches = 0;
+
+  public:
+    explicit ConstantFolder(SymbolTable &symbols) : symbols(symbols) {}
+
+    void run(AST &tree);
+
+    [[nodiscard]] std::size_t getNumFoldedOperations() const { return numFoldedOperations; }
+    [[nodiscard]] std::size_t getNumRemovedBranches() const { return numRemovedBranches; }
+
+  private:
+    void visitAssertNode(AssertNode *node);
+    void visitAssignmentNode(AssignmentNode *node);
+    void visitBinaryOperationNode(BinaryOperationNode *node);
+    void visitCallNode(CallNode *node);
+    void visitForStatementNode(ForStatementNode *node);
+    void visitFunctionNode(FunctionNode *node);
+    void visitIfStatementNode(IfStatementNode *node);
+    void visitMemberAccessNode(MemberAccessNode *node);
+    void visitSequenceNode(SequenceNode *node);
+    void visitStatementNode(StatementNode *node);
+    void visitUnaryOperationNode(UnaryOperationNode *node);
+    void visitVariableNode(VariableNode *node);
+
+    void visitChild(AstNode *node);
+    LiteralNode *replaceWithLiteral(AstNode *node, LiteralType type);
+    bool foldIntegerOperation(BinaryOperationNode *node, int64_t left, int64_t right);
+    bool foldFloatOperation(BinaryOperationNode *node, double left, double right);
+};
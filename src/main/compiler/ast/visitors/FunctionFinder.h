@@ -4,20 +4,26 @@
 #include "../../MetaTypes.h"
 #include "../AST.h"
 #include "../AstNode.h"
+#include "AstVisitor.h"
 
 #include <string>
 #include <vector>
 
-class FunctionFinder {
+class FunctionFinder : public AstVisitor<FunctionFinder> {
+    friend class AstVisitor<FunctionFinder>;
+
+    SymbolTable &symbols;
     std::vector<FunctionSignature> functions = {};
 
   public:
+    explicit FunctionFinder(SymbolTable &symbols) : symbols(symbols) {}
+
     std::vector<FunctionSignature> run(AST &tree);
 
+    /// the functions that have been found so far, for use with visitDeclarations
+    std::vector<FunctionSignature> &getFunctions() { return functions; }
+
   private:
-    void visitNode(AstNode *node);
     void visitFunctionNode(FunctionNode *node);
-    void visitSequenceNode(SequenceNode *node);
-    void visitStatementNode(StatementNode *node);
     void visitTypeDeclarationNode(TypeDeclarationNode *node);
 };
@@ -3,24 +3,29 @@
 #include "../../../Module.h"
 #include "../AST.h"
 #include "../AstNode.h"
+#include "AstVisitor.h"
 
 #include <filesystem>
 #include <string>
 #include <utility>
 #include <vector>
 
-class ImportFinder {
+class ImportFinder : public AstVisitor<ImportFinder> {
+    friend class AstVisitor<ImportFinder>;
+
+    const SymbolTable &symbols;
     std::filesystem::path directoryPath;
     std::vector<std::string> importedModules = {};
 
   public:
-    explicit ImportFinder(std::filesystem::path directoryPath) : directoryPath(std::move(directoryPath)) {}
+    ImportFinder(const SymbolTable &symbols, std::filesystem::path directoryPath)
+        : symbols(symbols), directoryPath(std::move(directoryPath)) {}
 
     std::vector<std::string> run(AST &tree);
 
+    /// the imports that have been found so far, for use with visitDeclarations
+    std::vector<std::string> &getImportedModules() { return importedModules; }
+
   private:
-    void visitNode(AstNode *node);
     void visitImportNode(ImportNode *node);
-    void visitSequenceNode(SequenceNode *node);
-    void visitStatementNode(StatementNode *node);
 };
@@ -14,19 +14,19 @@ void TypeAnalyzer::visitFunctionNode(FunctionNode *node) {
 void TypeAnalyzer::visitCallNode(CallNode *node) {
     auto result = functionResolver.resolveFunction(module, node->name);
     if (!result.functionExists) {
-        std::cerr << "TypeAnalyzer: Undefined function " << node->name << std::endl;
+        std::cerr << "TypeAnalyzer: Undefined function " << symbols.name(node->name) << std::endl;
         return;
     }
     for (auto *const arg : node->arguments) {
         visitNode(arg);
     }
-    nodeTypeMap[AST_NODE(node)] = result.signature.returnType;
+    nodeTypeMap[AST_NODE(node)] = result.signature->returnType;
 }
 
 void TypeAnalyzer::visitVariableNode(VariableNode *node) {
     const auto &itr = variableTypeMap.find(node->name);
     if (itr == variableTypeMap.end()) {
-        std::cerr << "TypeAnalyzer: Undefined variable " << node->name << std::endl;
+        std::cerr << "TypeAnalyzer: Undefined variable " << symbols.name(node->name) << std::endl;
         return;
     }
     nodeTypeMap[AST_NODE(node)] = itr->second;
@@ -174,7 +174,8 @@ void TypeAnalyzer::visitTypeDeclarationNode(TypeDeclarationNode *node) {
         };
         members.push_back(m);
     }
-    complexTypeMap[node->type()] = {node->type(), members};
+    const auto type = ast::DataType(symbols.name(node->name));
+    complexTypeMap[type] = {type, members};
 }
 
 void TypeAnalyzer::visitMemberAccessNode(MemberAccessNode *node) {
@@ -206,63 +207,8 @@ void TypeAnalyzer::visitMemberAccessNode(MemberAccessNode *node) {
     }
 }
 
-std::pair<std::unordered_map<AstNode *, ast::DataType>, std::unordered_map<std::string, ast::DataType>>
-TypeAnalyzer::run(AST &tree) {
+std::pair<AstNodeTable<ast::DataType>, std::unordered_map<SymbolId, ast::DataType>> TypeAnalyzer::run(AST &tree) {
+    nodeTypeMap = AstNodeTable<ast::DataType>(tree.size());
     visitNode(tree.root());
-    return std::make_pair(nodeTypeMap, variableTypeMap);
-}
-
-void TypeAnalyzer::visitNode(AstNode *node) {
-    switch (node->type) {
-    case ast::NodeType::SEQUENCE:
-        visitSequenceNode(&node->sequence);
-        break;
-    case ast::NodeType::STATEMENT:
-        visitStatementNode(&node->statement);
-        break;
-    case ast::NodeType::LITERAL:
-        visitLiteralNode(&node->literal);
-        break;
-    case ast::NodeType::UNARY_OPERATION:
-        visitUnaryOperationNode(&node->unary_operation);
-        break;
-    case ast::NodeType::BINARY_OPERATION:
-        visitBinaryOperationNode(&node->binary_operation);
-        break;
-    case ast::NodeType::FUNCTION:
-        visitFunctionNode(&node->function);
-        break;
-    case ast::NodeType::CALL:
-        visitCallNode(&node->call);
-        break;
-    case ast::NodeType::VARIABLE_DEFINITION:
-        visitVariableDefinitionNode(&node->variable_definition);
-        break;
-    case ast::NodeType::VARIABLE:
-        visitVariableNode(&node->variable);
-        break;
-    case ast::NodeType::ASSIGNMENT:
-        visitAssignmentNode(&node->assignment);
-        break;
-    case ast::NodeType::IF_STATEMENT:
-        visitIfStatementNode(&node->if_statement);
-        break;
-    case ast::NodeType::FOR_STATEMENT:
-        visitForStatementNode(&node->for_statement);
-        break;
-    case ast::NodeType::TYPE_DECLARATION:
-        visitTypeDeclarationNode(&node->type_declaration);
-        break;
-    case ast::NodeType::MEMBER_ACCESS:
-        visitMemberAccessNode(&node->member_access);
-        break;
-    case ast::NodeType::ASSERT:
-        visitAssertNode(&node->assert);
-        break;
-    case ast::NodeType::TYPE_MEMBER:
-    case ast::NodeType::IMPORT:
-    case ast::NodeType::COMMENT:
-        // do nothing
-        break;
-    }
+    return std::make_pair(std::move(nodeTypeMap), std::move(variableTypeMap));
 }
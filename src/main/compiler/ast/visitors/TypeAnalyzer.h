@@ -1,27 +1,31 @@
 #pragma once
 
 #include "../../FunctionResolver.h"
+#include "../AstNodeTable.h"
 #include "../Types.h"
+#include "AstVisitor.h"
 #include <unordered_map>
 
-class TypeAnalyzer {
+class TypeAnalyzer : public AstVisitor<TypeAnalyzer> {
+    friend class AstVisitor<TypeAnalyzer>;
+
     const Logger &log;
     Module *module;
     const FunctionResolver &functionResolver;
+    const SymbolTable &symbols;
 
-    std::unordered_map<AstNode *, ast::DataType> nodeTypeMap = {};
-    std::unordered_map<std::string, ast::DataType> variableTypeMap = {};
+    AstNodeTable<ast::DataType> nodeTypeMap = {};
+    std::unordered_map<SymbolId, ast::DataType> variableTypeMap = {};
     std::unordered_map<ast::DataType, ComplexType> complexTypeMap = {};
 
   public:
-    explicit TypeAnalyzer(const Logger &log, Module *module, const FunctionResolver &functionResolver)
-        : log(log), module(module), functionResolver(functionResolver) {}
+    explicit TypeAnalyzer(const Logger &log, Module *module, const FunctionResolver &functionResolver,
+                          const SymbolTable &symbols)
+        : log(log), module(module), functionResolver(functionResolver), symbols(symbols) {}
 
-    std::pair<std::unordered_map<AstNode *, ast::DataType>, std::unordered_map<std::string, ast::DataType>>
-    run(AST &tree);
+    std::pair<AstNodeTable<ast::DataType>, std::unordered_map<SymbolId, ast::DataType>> run(AST &tree);
 
   private:
-    void visitNode(AstNode *node);
     void visitAssertNode(AssertNode *node);
     void visitAssignmentNode(AssignmentNode *node);
     void visitBinaryOperationNode(BinaryOperationNode *node);
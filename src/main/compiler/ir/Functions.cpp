@@ -1,8 +1,7 @@
 #include "IrGenerator.h"
 
 #include <llvm/IR/Verifier.h>
-
-#define ENABLE_OPTIMIZATIONS 0
+#include <llvm/Support/raw_ostream.h>
 
 llvm::Function *IrGenerator::getOrCreateStdLibFunction(const std::string &functionName) {
     auto *func = llvmModule.getFunction(functionName);
@@ -81,7 +80,7 @@ llvm::Value *IrGenerator::createStdLibCall(const std::string &functionName, cons
 }
 
 void IrGenerator::visitFunctionNode(FunctionNode *node) {
-    log.debug("Enter Function");
+    LOG_DEBUG(log, "Enter Function");
 
     llvm::Function *previousFunction = currentFunction;
     bool previousGlobalScopeState = isGlobalScope;
@@ -91,10 +90,11 @@ void IrGenerator::visitFunctionNode(FunctionNode *node) {
         FunctionArgument newArg = {arg->name, arg->type};
         arguments.push_back(newArg);
     }
-    currentFunction = getOrCreateFunctionDefinition(node->name, node->returnType, arguments);
+    const std::string &functionName = symbols.name(node->name);
+    currentFunction = getOrCreateFunctionDefinition(functionName, node->returnType, arguments);
 
     if (!node->is_external()) {
-        llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + node->name, currentFunction);
+        llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + functionName, currentFunction);
         builder.SetInsertPoint(BB);
 
         withScope([this, &node]() {
@@ -104,7 +104,7 @@ void IrGenerator::visitFunctionNode(FunctionNode *node) {
                 // store initial value
                 builder.CreateStore(&arg, value);
 
-                currentScope().definedVariables[arg.getName().str()] = value;
+                defineVariable(node->arguments[arg.getArgNo()]->name, value);
             }
 
             visitNode(node->body);
@@ -127,7 +127,7 @@ void IrGenerator::visitFunctionNode(FunctionNode *node) {
     //      we should save that last insertion point somewhere, instead of guessing it here
     builder.SetInsertPoint(&currentFunction->getBasicBlockList().back());
 
-    log.debug("Exit Function");
+    LOG_DEBUG(log, "Exit Function");
 }
 
 llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const std::string &name, const ast::DataType &returnType,
@@ -156,14 +156,14 @@ llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const std::string &na
 
     unsigned int i = 0;
     for (auto &arg : function->args()) {
-        arg.setName(arguments[i++].name);
+        arg.setName(symbols.name(arguments[i++].name));
     }
 
     return function;
 }
 
 llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const FunctionSignature &signature) {
-    return getOrCreateFunctionDefinition(signature.name, signature.returnType, signature.arguments);
+    return getOrCreateFunctionDefinition(symbols.name(signature.name), signature.returnType, signature.arguments);
 }
 
 void IrGenerator::finalizeFunction(llvm::Function *function, const ast::DataType &returnType,
@@ -173,47 +173,31 @@ void IrGenerator::finalizeFunction(llvm::Function *function, const ast::DataType
         builder.CreateRetVoid();
     }
 
-    if (llvm::verifyFunction(*function, &llvm::errs())) {
+    std::string verifierOutput = {};
+    llvm::raw_string_ostream verifierStream(verifierOutput);
+    if (llvm::verifyFunction(*function, &verifierStream)) {
+        // the module is verified again once all modules have been merged, which stops the compilation
+        log.error("Invalid function " + function->getName().str() + ": " + verifierStream.str());
         return;
     }
 
     //    function->viewCFG();
-
-    // FIXME create command line option to switch optimizations on/off
-#if ENABLE_OPTIMIZATIONS
-    if (!isExternalFunction) {
-        bool verbose = false;
-        llvm::LoopAnalysisManager loopAnalysisManager(verbose);
-        llvm::FunctionAnalysisManager functionAnalysisManager(verbose);
-        llvm::CGSCCAnalysisManager cgsccAnalysisManager(verbose);
-        llvm::ModuleAnalysisManager moduleAnalysisManager(verbose);
-        llvm::PassBuilder passBuilder;
-        passBuilder.registerModuleAnalyses(moduleAnalysisManager);
-        passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
-        passBuilder.registerFunctionAnalyses(functionAnalysisManager);
-        passBuilder.registerLoopAnalyses(loopAnalysisManager);
-        passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager,
-                                         moduleAnalysisManager);
-        llvm::FunctionPassManager functionPassManager = passBuilder.buildFunctionSimplificationPipeline(
-              llvm::PassBuilder::OptimizationLevel::O0, llvm::PassBuilder::ThinLTOPhase::None, verbose);
-        functionPassManager.run(*function, functionAnalysisManager);
-    }
-#endif
 }
 
 void IrGenerator::visitCallNode(CallNode *node) {
-    log.debug("Enter Function Call");
+    LOG_DEBUG(log, "Enter Function Call");
 
-    llvm::Function *calleeFunc = llvmModule.getFunction(node->name);
+    const std::string &functionName = symbols.name(node->name);
+    llvm::Function *calleeFunc = llvmModule.getFunction(functionName);
     if (calleeFunc == nullptr) {
         const FunctionResolveResult resolveResult = functionResolver.resolveFunction(module, node->name);
         if (!resolveResult.functionExists) {
-            return logError("Undefined function '" + node->name + "'");
+            return logError("Undefined function '" + functionName + "'");
         }
 
-        calleeFunc = getOrCreateFunctionDefinition(resolveResult.signature);
+        calleeFunc = getOrCreateFunctionDefinition(*resolveResult.signature);
         if (calleeFunc == nullptr) {
-            return logError("Could not generate external definition for function '" + node->name + "'");
+            return logError("Could not generate external definition for function '" + functionName + "'");
         }
     }
 
@@ -224,14 +208,14 @@ void IrGenerator::visitCallNode(CallNode *node) {
     std::vector<llvm::Value *> arguments;
     for (auto &argument : node->arguments) {
         visitNode(argument);
-        auto itr = nodesToValues.find(argument);
-        if (itr == nodesToValues.end()) {
+        auto *value = nodesToValues[argument];
+        if (value == nullptr) {
             return logError("Could not generate code for argument.");
         }
         if (typeResolver.getTypeOf(module, argument) == ast::DataType(ast::SimpleDataType::STRING)) {
-            arguments.push_back(builder.CreateLoad(itr->second));
+            arguments.push_back(builder.CreateLoad(value));
         } else {
-            arguments.push_back(itr->second);
+            arguments.push_back(value);
         }
     }
 
@@ -243,10 +227,11 @@ void IrGenerator::visitCallNode(CallNode *node) {
     }
     nodesToValues[AST_NODE(node)] = call;
 
-    log.debug("Exit Function Call");
+    LOG_DEBUG(log, "Exit Function Call");
 }
 
 bool IrGenerator::isPrimitiveType(const ast::DataType &type) {
-    return type == ast::DataType(ast::SimpleDataType::BOOLEAN) || type == ast::DataType(ast::SimpleDataType::INTEGER) ||
-           type == ast::DataType(ast::SimpleDataType::FLOAT);
+    const auto simple = ast::toSimpleDataType(type);
+    return simple == ast::SimpleDataType::BOOLEAN || simple == ast::SimpleDataType::INTEGER ||
+           simple == ast::SimpleDataType::FLOAT;
 }
@@ -4,19 +4,22 @@
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/IR/Verifier.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/Utils/Cloning.h>
-
-#include <iostream>
+#include <llvm/Transforms/Utils/Mem2Reg.h>
 
 #include "util/Utils.h"
 
-IrGenerator::IrGenerator(const BuildEnv *buildEnv, Module *module, FunctionResolver &functionResolver,
-                         TypeResolver &typeResolver, const Logger &logger)
-    : buildEnv(buildEnv), module(module), functionResolver(functionResolver), typeResolver(typeResolver), log(logger),
-      context(module->llvmModule.getContext()), llvmModule(module->llvmModule), builder(context) {
+IrGenerator::IrGenerator(const BuildEnv *buildEnv, Module *module, const SymbolTable &symbols,
+                         FunctionResolver &functionResolver, TypeResolver &typeResolver, const Logger &logger)
+    : buildEnv(buildEnv), module(module), symbols(symbols), functionResolver(functionResolver),
+      typeResolver(typeResolver), log(logger), context(module->llvmModule.getContext()),
+      llvmModule(module->llvmModule), builder(context), nodesToValues(module->ast.size()) {
     pushScope();
 }
 
@@ -75,7 +78,7 @@ void IrGenerator::setupGlobalInitialization(llvm::Function *func) {
 }
 
 void IrGenerator::visitSequenceNode(SequenceNode *node) {
-    log.debug("Enter Sequence");
+    LOG_DEBUG(log, "Enter Sequence");
 
     llvm::Function *initFunc = nullptr;
     if (currentFunction == nullptr) {
@@ -106,7 +109,7 @@ void IrGenerator::visitSequenceNode(SequenceNode *node) {
         isGlobalScope = false;
     }
 
-    log.debug("Exit Sequence");
+    LOG_DEBUG(log, "Exit Sequence");
 }
 
 void IrGenerator::writeToFile() {
@@ -122,55 +125,60 @@ void IrGenerator::writeToFile() {
     dest.close();
 }
 
-void IrGenerator::run() {
+bool IrGenerator::run() {
     if (!module->ast.is_complete()) {
-        return;
+        return false;
     }
 
     visitNode(module->ast.root());
 
+    if (errors.empty() && buildEnv->promoteAllocas) {
+        promoteAllocas();
+    }
+
     this->printMetrics();
     if (!errors.empty()) {
         printErrors();
-        exit(1);
-    } else {
-        if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
-            llvmModule.print(llvm::outs(), nullptr);
-        }
+        return true;
     }
-}
 
-llvm::Value *IrGenerator::findVariable(const std::string &name) {
-    metrics["variableLookups"]++;
-
-    unsigned long currentScope = scopeStack.size() - 1;
-    while (currentScope >= 0) {
-        auto &scope = scopeStack[currentScope];
-        auto result = scope.definedVariables.find(name);
-
-        if (result != scope.definedVariables.end()) {
-            metrics["variableLookupsSuccessful"]++;
-            return result->second;
-        }
-
-        currentScope--;
+    // the logger of a module that is generated on another thread writes into a buffer of its own
+    if (log.isEnabled(Logger::DEBUG_)) {
+        std::string ir = {};
+        llvm::raw_string_ostream stream(ir);
+        llvmModule.print(stream, nullptr);
+        log.append(stream.str());
     }
+    return false;
+}
 
-    metrics["variableLookupsFailure"]++;
+llvm::Value *IrGenerator::findVariable(SymbolId name) {
+    metrics.variableLookups++;
 
-    return nullptr;
+    auto *result = variables.find(name);
+    if (result == nullptr) {
+        metrics.variableLookupsFailure++;
+    } else {
+        metrics.variableLookupsSuccessful++;
+    }
+    return result;
 }
 
+void IrGenerator::defineVariable(SymbolId name, llvm::Value *value) { variables.define(name, value); }
+
 Scope &IrGenerator::currentScope() { return scopeStack[scopeStack.size() - 1]; }
 
-void IrGenerator::pushScope() { scopeStack.emplace_back(); }
+void IrGenerator::pushScope() {
+    scopeStack.emplace_back();
+    variables.pushScope();
+}
 
 void IrGenerator::popScope() {
-    auto currentScope = scopeStack.back();
-    for (auto &func : currentScope.cleanUpFunctions) {
+    for (auto &func : scopeStack.back().cleanUpFunctions) {
         func();
     }
     scopeStack.pop_back();
+    variables.popScope();
 }
 
 void IrGenerator::withScope(const std::function<void(void)> &func) {
@@ -179,21 +187,62 @@ void IrGenerator::withScope(const std::function<void(void)> &func) {
     popScope();
 }
 
+namespace {
+
+std::size_t countAllocas(const llvm::Module &module) {
+    std::size_t result = 0;
+    for (const auto &function : module) {
+        for (const auto &instruction : llvm::instructions(function)) {
+            result += static_cast<std::size_t>(llvm::isa<llvm::AllocaInst>(instruction));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void IrGenerator::promoteAllocas() {
+    // all locals are allocated in the entry block of their function, which is exactly what mem2reg can promote
+    llvm::FunctionAnalysisManager functionAnalysisManager = {};
+    llvm::PassBuilder().registerFunctionAnalyses(functionAnalysisManager);
+    llvm::FunctionPassManager functionPassManager;
+    functionPassManager.addPass(llvm::PromotePass());
+
+    const bool collectMetrics = log.isEnabled(Logger::DEBUG_);
+    if (collectMetrics) {
+        metrics.allocasBeforePromotion = countAllocas(llvmModule);
+    }
+    for (auto &function : llvmModule) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+        // mem2reg expects well formed IR, broken functions are left alone and reported when the module is verified
+        if (llvm::verifyFunction(function)) {
+            LOG_DEBUG(log, "Not promoting the allocas of the invalid function " + function.getName().str());
+            continue;
+        }
+        functionPassManager.run(function, functionAnalysisManager);
+    }
+    if (collectMetrics) {
+        metrics.allocasAfterPromotion = countAllocas(llvmModule);
+    }
+}
+
 void IrGenerator::printMetrics() {
     if (log.getLogLevel() != Logger::LogLevel::DEBUG_) {
         return;
     }
 
-    for (const auto &metric : metrics) {
-        log.debug(metric.first + ": " + std::to_string(metric.second));
-    }
+    LOG_DEBUG(log, "variableLookups: " + std::to_string(metrics.variableLookups));
+    LOG_DEBUG(log, "variableLookupsSuccessful: " + std::to_string(metrics.variableLookupsSuccessful));
+    LOG_DEBUG(log, "variableLookupsFailure: " + std::to_string(metrics.variableLookupsFailure));
+    LOG_DEBUG(log, "allocasBeforePromotion: " + std::to_string(metrics.allocasBeforePromotion));
+    LOG_DEBUG(log, "allocasAfterPromotion: " + std::to_string(metrics.allocasAfterPromotion));
 }
 
 void IrGenerator::printErrors() {
-    std::cerr << std::endl;
-    std::cerr << "The following errors occured:" << std::endl;
+    log.error("The following errors occured in '" + module->getFilePath().string() + "':");
     for (const auto &msg : errors) {
-        std::cerr << "\t" << msg << std::endl;
+        log.error("\t" + msg);
     }
-    std::cerr << std::endl;
 }
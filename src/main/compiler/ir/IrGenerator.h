@@ -5,6 +5,8 @@
 #include "../FunctionResolver.h"
 #include "../TypeResolver.h"
 #include "../ast/AstNode.h"
+#include "../ast/AstNodeTable.h"
+#include "../ast/visitors/AstVisitor.h"
 #include "Scope.h"
 
 #include <iostream>
@@ -14,10 +16,12 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
-class IrGenerator {
+class IrGenerator : public AstVisitor<IrGenerator> {
+    friend class AstVisitor<IrGenerator>;
+
   public:
-    explicit IrGenerator(const BuildEnv *buildEnv, Module *module, FunctionResolver &functionResolver,
-                         TypeResolver &typeResolver, const Logger &logger);
+    explicit IrGenerator(const BuildEnv *buildEnv, Module *module, const SymbolTable &symbols,
+                         FunctionResolver &functionResolver, TypeResolver &typeResolver, const Logger &logger);
 
     void visitAssertNode(AssertNode *node);
     void visitAssignmentNode(AssignmentNode *node);
@@ -35,13 +39,15 @@ class IrGenerator {
     void visitVariableNode(VariableNode *node);
     void visitVariableDefinitionNode(VariableDefinitionNode *node);
 
-    void run();
+    /// generates the IR of the module, returns true if there was an error (the errors are written to the logger)
+    bool run();
 
     void writeToFile();
 
   private:
     const BuildEnv *buildEnv;
     Module *module;
+    const SymbolTable &symbols;
     FunctionResolver &functionResolver;
     TypeResolver &typeResolver;
     const Logger &log;
@@ -50,28 +56,41 @@ class IrGenerator {
     llvm::Module &llvmModule;
     llvm::IRBuilder<> builder;
 
-    std::unordered_map<std::string, int> metrics = {};
+    struct Metrics {
+        std::size_t variableLookups = 0;
+        std::size_t variableLookupsSuccessful = 0;
+        std::size_t variableLookupsFailure = 0;
+        std::size_t allocasBeforePromotion = 0;
+        std::size_t allocasAfterPromotion = 0;
+    };
+    Metrics metrics = {};
     std::vector<std::string> errors = {};
 
     llvm::Function *currentFunction = nullptr;
     bool isGlobalScope = false;
-    std::unordered_map<AstNode *, llvm::Value *> nodesToValues = {};
+    AstNodeTable<llvm::Value *> nodesToValues = {};
     std::vector<Scope> scopeStack = {};
+    VariableTable variables = {};
+    /// the llvm types of all types that have been used so far, indexed by ast::TypeId
+    std::vector<llvm::Type *> typeCache = {};
 
     // This is used to save a pointer to write to (for structs)
     llvm::Value *currentDestination = nullptr;
 
-    llvm::Value *findVariable(const std::string &name);
+    llvm::Value *findVariable(SymbolId name);
+    void defineVariable(SymbolId name, llvm::Value *value);
     Scope &currentScope();
     void pushScope();
     void popScope();
     void withScope(const std::function<void(void)> &func);
 
+    void promoteAllocas();
     void printMetrics();
     void printErrors();
 
     void logError(const std::string &msg);
     llvm::Type *getType(const ast::DataType &type);
+    llvm::Type *createType(const ast::DataType &type);
     llvm::Function *getOrCreateFunctionDefinition(const std::string &name, const ast::DataType &returnType,
                                                   const std::vector<FunctionArgument> &arguments);
     llvm::Function *getOrCreateFunctionDefinition(const FunctionSignature &signature);
@@ -93,6 +112,5 @@ class IrGenerator {
     llvm::Value *createStdLibCall(const std::string &functionName, const std::vector<llvm::Value *> &args);
 
     std::string getTypeFormatSpecifier(AstNode *node);
-    void visitNode(AstNode *node);
     void visitLiteralNode(LiteralNode *node);
 };
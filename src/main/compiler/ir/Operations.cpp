@@ -160,7 +160,7 @@ void IrGenerator::emitBooleanOperation(BinaryOperationNode *node, llvm::Value *l
 }
 
 void IrGenerator::visitBinaryOperationNode(BinaryOperationNode *node) {
-    log.debug("Enter BinaryOperation");
+    LOG_DEBUG(log, "Enter BinaryOperation");
 
     visitNode(node->left);
     auto *l = nodesToValues[node->left];
@@ -171,8 +171,8 @@ void IrGenerator::visitBinaryOperationNode(BinaryOperationNode *node) {
         return logError("Generating left or right side failed.");
     }
 
-    ast::DataType typeOfLeft = typeResolver.getTypeOf(module, node->left);
-    ast::DataType typeOfRight = typeResolver.getTypeOf(module, node->right);
+    const ast::DataType &typeOfLeft = typeResolver.getTypeOf(module, node->left);
+    const ast::DataType &typeOfRight = typeResolver.getTypeOf(module, node->right);
     if (typeOfLeft != typeOfRight) {
         return logError("Types " + to_string(typeOfLeft) + " and " + to_string(typeOfRight) +
                         " are not compatible for binary operation");
@@ -191,11 +191,11 @@ void IrGenerator::visitBinaryOperationNode(BinaryOperationNode *node) {
                         to_string(typeOfRight));
     }
 
-    log.debug("Exit BinaryOperation");
+    LOG_DEBUG(log, "Exit BinaryOperation");
 }
 
 void IrGenerator::visitUnaryOperationNode(UnaryOperationNode *node) {
-    log.debug("Enter UnaryOperation");
+    LOG_DEBUG(log, "Enter UnaryOperation");
 
     visitNode(node->child);
     auto *c = nodesToValues[AST_NODE(node->child)];
@@ -222,5 +222,5 @@ void IrGenerator::visitUnaryOperationNode(UnaryOperationNode *node) {
         break;
     }
 
-    log.debug("Exit UnaryOperation");
+    LOG_DEBUG(log, "Exit UnaryOperation");
 }
@@ -5,12 +5,63 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../SymbolTable.h"
+
 class Scope {
   public:
     Scope() = default;
 
-    std::unordered_map<std::string, llvm::Value *> definedVariables = {};
-
     // TODO find a better name
     std::vector<std::function<void(void)>> cleanUpFunctions = {};
 };
+
+/**
+ * The variables that are visible at the current point of the IR generation. All scopes share one hash table that maps
+ * each name to its innermost definition, so a lookup is a single probe no matter how deeply the scopes are nested.
+ * Definitions that shadow another one are recorded in an undo log, which popScope replays to restore the outer ones.
+ */
+class VariableTable {
+  public:
+    void pushScope() { scopeStarts.push_back(undoLog.size()); }
+
+    void popScope() {
+        const auto scopeStart = scopeStarts.back();
+        scopeStarts.pop_back();
+        // undo in reverse order, so that a name that was defined twice in the scope gets its outer definition back
+        while (undoLog.size() > scopeStart) {
+            const auto &entry = undoLog.back();
+            if (entry.previous == nullptr) {
+                variables.erase(entry.name);
+            } else {
+                variables[entry.name] = entry.previous;
+            }
+            undoLog.pop_back();
+        }
+    }
+
+    void define(SymbolId name, llvm::Value *value) {
+        auto &binding = variables[name];
+        undoLog.push_back({name, binding});
+        binding = value;
+    }
+
+    [[nodiscard]] llvm::Value *find(SymbolId name) const {
+        auto itr = variables.find(name);
+        if (itr == variables.end()) {
+            return nullptr;
+        }
+        return itr->second;
+    }
+
+  private:
+    struct UndoEntry {
+        SymbolId name;
+        /// the definition that was visible before, nullptr if there was none
+        llvm::Value *previous;
+    };
+
+    std::unordered_map<SymbolId, llvm::Value *> variables = {};
+    std::vector<UndoEntry> undoLog = {};
+    /// the size of the undo log when each of the current scopes was entered
+    std::vector<std::size_t> scopeStarts = {};
+};
@@ -1,7 +1,7 @@
 #include "IrGenerator.h"
 
 void IrGenerator::visitStatementNode(StatementNode *node) {
-    log.debug("Enter Statement");
+    LOG_DEBUG(log, "Enter Statement");
 
     if (node->child == nullptr) {
         return;
@@ -14,7 +14,7 @@ void IrGenerator::visitStatementNode(StatementNode *node) {
     }
     nodesToValues[AST_NODE(node)] = value;
 
-    log.debug("Exit Statement");
+    LOG_DEBUG(log, "Exit Statement");
 }
 
 bool hasReturnStatement(AstNode *node) {
@@ -47,7 +47,23 @@ bool hasReturnStatement(AstNode *node) {
 }
 
 void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
-    log.debug("Enter IfStatement");
+    LOG_DEBUG(log, "Enter IfStatement");
+
+    if (buildEnv->foldConstants && node->condition->type == ast::NodeType::LITERAL &&
+        node->condition->literal.type == LiteralType::BOOL) {
+        // the ConstantFolder already removed the branch that can never be taken
+        auto *body = node->condition->literal.b ? node->ifBody : node->elseBody;
+        if (body != nullptr) {
+            withScope([this, &body]() { visitNode(body); });
+        }
+        if (hasReturnStatement(body)) {
+            // the code after the if statement is unreachable, it still needs a block to be generated into
+            llvm::Function *function = builder.GetInsertBlock()->getParent();
+            builder.SetInsertPoint(llvm::BasicBlock::Create(context, "if_merge", function));
+        }
+        LOG_DEBUG(log, "Exit IfStatement");
+        return;
+    }
 
     visitNode(node->condition);
     auto *condition = nodesToValues[node->condition];
@@ -82,11 +98,11 @@ void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
     function->getBasicBlockList().push_back(mergeBB);
     builder.SetInsertPoint(mergeBB);
 
-    log.debug("Exit IfStatement");
+    LOG_DEBUG(log, "Exit IfStatement");
 }
 
 void IrGenerator::visitForStatementNode(ForStatementNode *node) {
-    log.debug("Enter ForStatement");
+    LOG_DEBUG(log, "Enter ForStatement");
     pushScope();
 
     visitNode(node->init);
@@ -117,11 +133,11 @@ void IrGenerator::visitForStatementNode(ForStatementNode *node) {
 
     builder.SetInsertPoint(loopExitBB);
 
-    log.debug("Exit ForStatement");
+    LOG_DEBUG(log, "Exit ForStatement");
 }
 
 std::string IrGenerator::getTypeFormatSpecifier(AstNode* node) {
-    auto type = typeResolver.getTypeOf(module, node);
+    const auto &type = typeResolver.getTypeOf(module, node);
     if (type == ast::DataType(ast::SimpleDataType::INTEGER)) {
         return "ld";
     }
@@ -132,7 +148,7 @@ std::string IrGenerator::getTypeFormatSpecifier(AstNode* node) {
 }
 
 void IrGenerator::visitAssertNode(AssertNode *node) {
-    log.debug("Enter Assert");
+    LOG_DEBUG(log, "Enter Assert");
 
     visitNode(node->condition);
     auto *condition = nodesToValues[node->condition];
@@ -189,5 +205,5 @@ void IrGenerator::visitAssertNode(AssertNode *node) {
     function->getBasicBlockList().push_back(mergeBB);
     builder.SetInsertPoint(mergeBB);
 
-    log.debug("Exit Assert");
+    LOG_DEBUG(log, "Exit Assert");
 }
@@ -3,6 +3,23 @@
 const int NUM_BITS_OF_INT = 64;
 
 llvm::Type *IrGenerator::getType(const ast::DataType &type) {
+    if (type.id < typeCache.size() && typeCache[type.id] != nullptr) {
+        return typeCache[type.id];
+    }
+
+    const auto numErrors = errors.size();
+    auto *result = createType(type);
+    // types that could not be generated are replaced with void, they are not cached so that each use is reported
+    if (result != nullptr && errors.size() == numErrors) {
+        if (type.id >= typeCache.size()) {
+            typeCache.resize(static_cast<std::size_t>(type.id) + 1);
+        }
+        typeCache[type.id] = result;
+    }
+    return result;
+}
+
+llvm::Type *IrGenerator::createType(const ast::DataType &type) {
     bool isSimpleType = ast::isSimpleDataType(type);
     if (isSimpleType) {
         ast::SimpleDataType simpleDataType = toSimpleDataType(type);
@@ -27,7 +44,7 @@ llvm::Type *IrGenerator::getType(const ast::DataType &type) {
             return llvm::Type::getVoidTy(context);
         }
 
-        auto *result = getOrCreateComplexType(resolveResult.complexType);
+        auto *result = getOrCreateComplexType(*resolveResult.complexType);
         if (result == nullptr) {
             logError("Could not generate type declaration for type '" + to_string(type) + "'");
             return llvm::Type::getVoidTy(context);
@@ -37,15 +54,16 @@ llvm::Type *IrGenerator::getType(const ast::DataType &type) {
 }
 
 llvm::StructType *IrGenerator::getOrCreateComplexType(const ComplexType &type) {
-    auto *result = llvm::StructType::getTypeByName(context, type.type.typeName);
-    if (result != nullptr) {
-        return result;
-    }
     std::vector<llvm::Type *> elements = {};
     for (const auto &member : type.members) {
         elements.push_back(getType(member.type));
     }
-    return llvm::StructType::create(context, elements, type.type.typeName);
+    auto *result = llvm::StructType::getTypeByName(context, type.type.name());
+    // the members of the type might have changed since the IR has been generated the last time
+    if (result != nullptr && result->elements() == llvm::makeArrayRef(elements)) {
+        return result;
+    }
+    return llvm::StructType::create(context, elements, type.type.name());
 }
 
 llvm::StructType *IrGenerator::getStringType() {
@@ -66,15 +84,15 @@ void IrGenerator::visitLiteralNode(LiteralNode *node) {
     switch (node->type) {
     case LiteralType::BOOL:
         nodesToValues[AST_NODE(node)] = llvm::ConstantInt::get(context, llvm::APInt(1, static_cast<uint64_t>(node->b)));
-        log.debug("Created Bool");
+        LOG_DEBUG(log, "Created Bool");
         break;
     case LiteralType::INTEGER:
         nodesToValues[AST_NODE(node)] = llvm::ConstantInt::get(context, llvm::APInt(NUM_BITS_OF_INT, node->i));
-        log.debug("Created Integer");
+        LOG_DEBUG(log, "Created Integer");
         break;
     case LiteralType::FLOAT:
         nodesToValues[AST_NODE(node)] = llvm::ConstantFP::get(context, llvm::APFloat(node->d));
-        log.debug("Created Float");
+        LOG_DEBUG(log, "Created Float");
         break;
     case LiteralType::STRING:
         visitStringNode(node);
@@ -88,7 +106,7 @@ void IrGenerator::visitStringNode(LiteralNode *node) {
     //      call function that inits string
     // going with second option for now
 
-    const std::string stringValue = node->s;
+    const std::string &stringValue = symbols.name(node->s);
     unsigned int numCharacters = stringValue.size();
     auto *data = builder.CreateGlobalStringPtr(stringValue, "str");
     auto *size = llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), numCharacters);
@@ -112,19 +130,22 @@ void IrGenerator::visitStringNode(LiteralNode *node) {
         createStdLibCall("deleteString", args);
     });
 
-    log.debug("Created String");
+    LOG_DEBUG(log, "Created String");
 }
 
 void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
-    auto *functionDef = getOrCreateFunctionDefinition(node->name, node->type(), {});
-    llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + node->name, functionDef);
+    const std::string &name = symbols.name(node->name);
+    const auto type = ast::DataType(name);
+    auto *functionDef = getOrCreateFunctionDefinition(name, type, {});
+    llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + name, functionDef);
     builder.SetInsertPoint(BB);
 
-    auto *complexType = getType(node->type());
-    auto dataLayout = llvmModule.getDataLayout();
-    auto typeSize = dataLayout.getTypeAllocSize(complexType);
-    auto fixedTypeSize = typeSize.getFixedSize();
-    std::vector<llvm::Value *> args = {llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), fixedTypeSize)};
+    auto *complexType = getType(type);
+    // complexType is a pointer to the struct, the allocation needs the size of the struct itself.
+    // The data layout of the target is only set when the modules are merged, so the size is left as a constant
+    // expression that is folded once the layout is known.
+    auto *typeSize = llvm::ConstantExpr::getSizeOf(complexType->getPointerElementType());
+    std::vector<llvm::Value *> args = {typeSize};
     auto *result = createStdLibCall("malloc", args);
     auto *castedResult = builder.CreateBitOrPointerCast(result, complexType);
 
@@ -133,7 +154,7 @@ void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
 
         auto *memberType = getType(member->variable_definition->type);
 
-        auto llvmT = getType(node->type());
+        auto llvmT = getType(type);
         auto elementType = llvmT->getPointerElementType();
 
         llvm::Value *indexOfBaseVariable = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
@@ -142,7 +163,7 @@ void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
 
         auto address = builder.CreateInBoundsGEP(elementType, castedResult, indices, "memberAccess");
         if (!ast::isSimpleDataType(member->variable_definition->type)) {
-            auto subTypeFuncDef = getOrCreateFunctionDefinition(member->variable_definition->type.typeName,
+            auto subTypeFuncDef = getOrCreateFunctionDefinition(member->variable_definition->type.name(),
                                                                 member->variable_definition->type, {});
             auto funcResult = builder.CreateCall(subTypeFuncDef, {});
             builder.CreateStore(funcResult, address);
@@ -162,7 +183,7 @@ void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
                 value = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 0);
                 break;
             case ast::SimpleDataType::FLOAT:
-                value = llvm::ConstantFP::get(llvm::Type::getFloatTy(context), 0);
+                value = llvm::ConstantFP::get(llvm::Type::getDoubleTy(context), 0);
                 break;
             case ast::SimpleDataType::BOOLEAN:
                 value = llvm::ConstantInt::get(llvm::Type::getInt1Ty(context), 0);
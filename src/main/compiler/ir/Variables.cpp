@@ -3,11 +3,11 @@
 #include "util/Utils.h"
 
 void IrGenerator::visitVariableNode(VariableNode *node) {
-    log.debug("Enter Variable");
+    LOG_DEBUG(log, "Enter Variable");
 
     auto *value = findVariable(node->name);
     if (value == nullptr) {
-        return logError("Undefined variable '" + node->name + "'");
+        return logError("Undefined variable '" + symbols.name(node->name) + "'");
     }
 
     if (node->is_array_access()) {
@@ -19,7 +19,7 @@ void IrGenerator::visitVariableNode(VariableNode *node) {
         nodesToValues[AST_NODE(node)] = builder.CreateLoad(elementPtr);
     } else {
         if (isPrimitiveType(typeResolver.getTypeOf(module, AST_NODE(node)))) {
-            llvm::Value *loadedValue = builder.CreateLoad(value, node->name);
+            llvm::Value *loadedValue = builder.CreateLoad(value, symbols.name(node->name));
             nodesToValues[AST_NODE(node)] = loadedValue;
         } else {
             // this directly passes the pointer, instead of loading the value first
@@ -27,14 +27,14 @@ void IrGenerator::visitVariableNode(VariableNode *node) {
         }
     }
 
-    log.debug("Exit Variable");
+    LOG_DEBUG(log, "Exit Variable");
 }
 
 void IrGenerator::visitVariableDefinitionNode(VariableDefinitionNode *node) {
-    log.debug("Enter VariableDefinition");
+    LOG_DEBUG(log, "Enter VariableDefinition");
 
     llvm::Type *type = getType(node->type);
-    std::string &name = node->name;
+    const std::string &name = symbols.name(node->name);
 
     if (node->is_array()) {
         type = llvm::ArrayType::get(type, node->arraySize);
@@ -64,14 +64,14 @@ void IrGenerator::visitVariableDefinitionNode(VariableDefinitionNode *node) {
         }
     }
 
-    currentScope().definedVariables[name] = value;
+    defineVariable(node->name, value);
     nodesToValues[AST_NODE(node)] = value;
 
-    log.debug("Exit VariableDefinition");
+    LOG_DEBUG(log, "Exit VariableDefinition");
 }
 
 void IrGenerator::visitAssignmentNode(AssignmentNode *node) {
-    log.debug("Enter Assignment");
+    LOG_DEBUG(log, "Enter Assignment");
 
     llvm::Value *dest = nullptr;
     if (node->left->type == ast::NodeType::VARIABLE_DEFINITION) {
@@ -124,11 +124,11 @@ void IrGenerator::visitAssignmentNode(AssignmentNode *node) {
         nodesToValues[AST_NODE(node)] = builder.CreateStore(src, dest);
     }
 
-    log.debug("Exit Assignment");
+    LOG_DEBUG(log, "Exit Assignment");
 }
 
 void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
-    log.debug("Enter MemberAccess");
+    LOG_DEBUG(log, "Enter MemberAccess");
 
     auto variables = node->linearize_access_tree();
     if (variables.empty()) {
@@ -151,15 +151,15 @@ void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
 
         int memberIndex = -1;
         bool isComplexType = false;
-        for (int j = 0; j < resolveResult.complexType.members.size(); j++) {
-            if (resolveResult.complexType.members[j].name == variables[i]->name) {
+        for (int j = 0; j < resolveResult.complexType->members.size(); j++) {
+            if (resolveResult.complexType->members[j].name == variables[i]->name) {
                 memberIndex = j;
-                isComplexType = !ast::isSimpleDataType(resolveResult.complexType.members[j].type);
+                isComplexType = !ast::isSimpleDataType(resolveResult.complexType->members[j].type);
                 break;
             }
         }
         if (memberIndex == -1) {
-            return logError("Could not find member: " + variables[i]->name);
+            return logError("Could not find member: " + symbols.name(variables[i]->name));
         }
 
         llvm::Value *indexOfMember = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), memberIndex);
@@ -192,59 +192,5 @@ void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
 
     nodesToValues[AST_NODE(node)] = result;
 
-    log.debug("Exit MemberAccess");
-}
-
-void IrGenerator::visitNode(AstNode *node) {
-    switch (node->type) {
-    case ast::NodeType::SEQUENCE:
-        visitSequenceNode(&node->sequence);
-        break;
-    case ast::NodeType::STATEMENT:
-        visitStatementNode(&node->statement);
-        break;
-    case ast::NodeType::LITERAL:
-        visitLiteralNode(&node->literal);
-        break;
-    case ast::NodeType::UNARY_OPERATION:
-        visitUnaryOperationNode(&node->unary_operation);
-        break;
-    case ast::NodeType::BINARY_OPERATION:
-        visitBinaryOperationNode(&node->binary_operation);
-        break;
-    case ast::NodeType::FUNCTION:
-        visitFunctionNode(&node->function);
-        break;
-    case ast::NodeType::CALL:
-        visitCallNode(&node->call);
-        break;
-    case ast::NodeType::VARIABLE_DEFINITION:
-        visitVariableDefinitionNode(&node->variable_definition);
-        break;
-    case ast::NodeType::VARIABLE:
-        visitVariableNode(&node->variable);
-        break;
-    case ast::NodeType::ASSIGNMENT:
-        visitAssignmentNode(&node->assignment);
-        break;
-    case ast::NodeType::IF_STATEMENT:
-        visitIfStatementNode(&node->if_statement);
-        break;
-    case ast::NodeType::FOR_STATEMENT:
-        visitForStatementNode(&node->for_statement);
-        break;
-    case ast::NodeType::TYPE_DECLARATION:
-        visitTypeDeclarationNode(&node->type_declaration);
-        break;
-    case ast::NodeType::MEMBER_ACCESS:
-        visitMemberAccessNode(&node->member_access);
-        break;
-    case ast::NodeType::ASSERT:
-        visitAssertNode(&node->assert);
-        break;
-    case ast::NodeType::COMMENT:
-    case ast::NodeType::TYPE_MEMBER:
-    case ast::NodeType::IMPORT:
-        break;
-    }
+    LOG_DEBUG(log, "Exit MemberAccess");
 }
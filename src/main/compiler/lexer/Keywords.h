@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "Token.h"
+
+namespace keywords {
+
+struct Keyword {
+    std::string_view word;
+    Token::TokenType type = Token::INVALID;
+};
+
+constexpr std::array<Keyword, 18> KEYWORDS = {{
+      {"true", Token::BOOLEAN},
+      {"false", Token::BOOLEAN},
+      {"not", Token::NOT},
+      {"and", Token::AND},
+      {"or", Token::OR},
+      {"fun", Token::FUN},
+      {"type", Token::TYPE},
+      {"int", Token::SIMPLE_DATA_TYPE},
+      {"float", Token::SIMPLE_DATA_TYPE},
+      {"bool", Token::SIMPLE_DATA_TYPE},
+      {"string", Token::SIMPLE_DATA_TYPE},
+      {"return", Token::RETURN},
+      {"extern", Token::EXTERN},
+      {"if", Token::IF},
+      {"else", Token::ELSE},
+      {"for", Token::FOR},
+      {"import", Token::IMPORT},
+      {"assert", Token::ASSERT},
+}};
+
+constexpr std::size_t TABLE_SIZE = 32;
+
+// NOTE the coefficients have been chosen so that every keyword ends up in its own slot (checked below)
+constexpr std::size_t hash(std::string_view word) {
+    if (word.size() < 2) {
+        return 0;
+    }
+    const auto first = static_cast<unsigned char>(word[0]);
+    const auto second = static_cast<unsigned char>(word[1]);
+    return (first + 22 * second + 2 * word.size()) % TABLE_SIZE;
+}
+
+constexpr std::array<Keyword, TABLE_SIZE> createTable() {
+    std::array<Keyword, TABLE_SIZE> table = {};
+    for (const auto &keyword : KEYWORDS) {
+        table[hash(keyword.word)] = keyword;
+    }
+    return table;
+}
+
+constexpr std::array<Keyword, TABLE_SIZE> TABLE = createTable();
+
+constexpr bool isPerfectHash() {
+    for (const auto &keyword : KEYWORDS) {
+        if (TABLE[hash(keyword.word)].word != keyword.word) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isPerfectHash(), "keyword hash has collisions");
+
+/// Returns the token type of the given keyword or Token::IDENTIFIER, if the word is not a keyword
+constexpr Token::TokenType lookup(std::string_view word) {
+    const auto &entry = TABLE[hash(word)];
+    if (entry.word == word) {
+        return entry.type;
+    }
+    return Token::IDENTIFIER;
+}
+
+} // namespace keywords
@@ -1,74 +1,526 @@
 #include "Lexer.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <regex>
+#include <sstream>
 
+#include "Keywords.h"
+#include "util/ThreadPool.h"
 #include "util/Utils.h"
 
-std::optional<std::string> ByteCodeProvider::getMoreCode() {
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// returns the line starting at position (including the line break) and moves position to the start of the next line
+std::optional<std::string_view> nextLine(std::string_view code, std::size_t &position) {
+    if (position >= code.size()) {
+        return {};
+    }
+
+    auto lineEnd = code.find('\n', position);
+    if (lineEnd == std::string_view::npos) {
+        lineEnd = code.size();
+    } else {
+        lineEnd++;
+    }
+
+    auto result = code.substr(position, lineEnd - position);
+    position = lineEnd;
+    return std::optional(result);
+}
+
+/**
+ * Splits the code into pieces of roughly chunkSize bytes, each of which ends with a line break (except for the last
+ * one). Tokens never span multiple lines (strings end at the closing quote and comments include the line break), so
+ * every line break is a safe place to split the code.
+ */
+std::vector<std::string_view> splitIntoChunks(std::string_view code, std::size_t chunkSize) {
+    std::vector<std::string_view> chunks = {};
+    std::size_t start = 0;
+    while (start < code.size()) {
+        if (code.size() - start <= chunkSize) {
+            chunks.push_back(code.substr(start));
+            break;
+        }
+
+        auto end = code.find('\n', start + chunkSize);
+        if (end == std::string_view::npos) {
+            chunks.push_back(code.substr(start));
+            break;
+        }
+
+        end++;
+        chunks.push_back(code.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+} // namespace
+
+std::optional<std::string_view> BufferCodeProvider::getMoreCode() { return nextLine(code, position); }
+
+std::optional<std::string_view> BufferCodeProvider::getRemainingCode() {
+    auto result = code.substr(std::min(position, code.size()));
+    position = code.size();
+    return std::optional(result);
+}
+
+std::optional<std::string_view> ByteCodeProvider::getMoreCode() {
     if (size == 0) {
         return {};
     }
 
-    std::string s;
-    while (*data != '\n' && size > 0) {
-        s += *data;
+    const char *start = data;
+    while (size > 0 && *data != '\n') {
         data++;
         size--;
     }
-    if (*data == '\n' && size > 0) {
+    std::string_view result(start, data - start);
+    if (size > 0 && *data == '\n') {
         data++;
         size--;
     }
-    return std::optional<std::string>(s);
+    return std::optional(result);
+}
+
+FileCodeProvider::~FileCodeProvider() {
+#ifndef WIN32
+    if (mappedMemory != nullptr) {
+        munmap(mappedMemory, mappedSize);
+    }
+#endif
+}
+
+void FileCodeProvider::readFile() {
+#ifdef WIN32
+    std::ifstream infile(fileName, std::ios::in | std::ios::binary);
+    if (!infile.good()) {
+        std::cerr << "Could not read file '" << fileName << "'." << std::endl;
+        return;
+    }
+    fileContent.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+    code = fileContent;
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Could not read file '" << fileName << "'." << std::endl;
+        return;
+    }
+
+    struct stat fileStats = {};
+    if (fstat(fd, &fileStats) == -1) {
+        std::cerr << "Could not read file '" << fileName << "'." << std::endl;
+        close(fd);
+        return;
+    }
+
+    // NOTE mapping an empty file is not allowed
+    if (fileStats.st_size > 0) {
+        mappedSize = static_cast<std::size_t>(fileStats.st_size);
+        void *memory = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (memory == MAP_FAILED) {
+            std::cerr << "Could not map file '" << fileName << "' into memory." << std::endl;
+            mappedSize = 0;
+        } else {
+            mappedMemory = memory;
+            code = std::string_view(static_cast<const char *>(mappedMemory), mappedSize);
+        }
+    }
+
+    close(fd);
+#endif
 }
 
-std::optional<std::string> FileCodeProvider::getMoreCode() {
+std::optional<std::string_view> FileCodeProvider::getMoreCode() {
     if (!fileHasBeenRead) {
         fileHasBeenRead = true;
-        std::ifstream infile(fileName);
-        if (!infile.good()) {
-            std::cerr << "Could not read file '" << fileName << "'." << std::endl;
-        }
-        std::string line;
-        while (std::getline(infile, line)) {
-            lines.push_back(line + "\n");
-        }
+        readFile();
     }
 
-    if (lines.empty()) {
-        return {};
+    return nextLine(code, position);
+}
+
+std::optional<std::string_view> FileCodeProvider::getRemainingCode() {
+    if (!fileHasBeenRead) {
+        fileHasBeenRead = true;
+        readFile();
     }
 
-    std::string result = lines.front();
-    lines.erase(lines.begin());
+    auto result = code.substr(std::min(position, code.size()));
+    position = code.size();
     return std::optional(result);
 }
 
-std::optional<std::string> StringCodeProvider::getMoreCode() {
-    if (lines.empty()) {
+StringCodeProvider::StringCodeProvider(std::vector<std::string> _lines, bool addLineBreaks)
+    : lines(std::move(_lines)) {
+    if (addLineBreaks) {
+        for (auto &line : lines) {
+            line += "\n";
+        }
+    }
+}
+
+std::optional<std::string_view> StringCodeProvider::getMoreCode() {
+    if (nextLine >= lines.size()) {
         return {};
     }
-    std::string result = lines.front();
-    if (addLineBreaks) {
-        result += "\n";
+    return std::optional<std::string_view>(lines[nextLine++]);
+}
+
+std::string_view removeLeadingWhitespace(std::string_view str) {
+    while (!str.empty() && (str[0] == ' ' || str[0] == '\t')) {
+        str.remove_prefix(1);
     }
-    lines.erase(lines.begin());
-    return std::optional(result);
+    return str;
+}
+
+namespace {
+
+enum class CharacterClass : uint8_t {
+    OTHER,
+    WHITESPACE,
+    NEW_LINE,
+    LETTER,
+    DIGIT,
+    DOT,
+    QUOTE,
+    HASH,
+    OPERATOR,
+    EQUALS,
+    COMPARISON,
+    COUNT,
+};
+
+enum class State : uint8_t {
+    START,
+    IDENTIFIER,
+    INTEGER,
+    INTEGER_DOT,
+    FLOAT,
+    STRING,
+    STRING_END,
+    COMMENT,
+    COMMENT_END,
+    NEW_LINE_END,
+    OPERATOR_END,
+    COMPARISON,
+    COMPARISON_EQUALS,
+    STOP,
+    COUNT,
+};
+
+constexpr auto NUM_CHARACTER_CLASSES = static_cast<std::size_t>(CharacterClass::COUNT);
+constexpr auto NUM_STATES = static_cast<std::size_t>(State::COUNT);
+
+using CharacterClassTable = std::array<CharacterClass, 256>;
+using TransitionTable = std::array<std::array<State, NUM_CHARACTER_CLASSES>, NUM_STATES>;
+using TokenTypeTable = std::array<Token::TokenType, 256>;
+
+constexpr CharacterClassTable createCharacterClasses() {
+    CharacterClassTable result = {};
+    for (auto &c : result) {
+        c = CharacterClass::OTHER;
+    }
+    for (char c = 'a'; c <= 'z'; c++) {
+        result[c] = CharacterClass::LETTER;
+    }
+    for (char c = 'A'; c <= 'Z'; c++) {
+        result[c] = CharacterClass::LETTER;
+    }
+    result['_'] = CharacterClass::LETTER;
+    for (char c = '0'; c <= '9'; c++) {
+        result[c] = CharacterClass::DIGIT;
+    }
+    result[' '] = CharacterClass::WHITESPACE;
+    result['\t'] = CharacterClass::WHITESPACE;
+    result['\n'] = CharacterClass::NEW_LINE;
+    result['.'] = CharacterClass::DOT;
+    result['"'] = CharacterClass::QUOTE;
+    result['#'] = CharacterClass::HASH;
+    for (char c : {'(', ')', '{', '}', '[', ']', '+', '-', '*', '/', ',', ';'}) {
+        result[c] = CharacterClass::OPERATOR;
+    }
+    result['='] = CharacterClass::EQUALS;
+    result['<'] = CharacterClass::COMPARISON;
+    result['>'] = CharacterClass::COMPARISON;
+    result['!'] = CharacterClass::COMPARISON;
+    return result;
 }
 
-std::string removeLeadingWhitespace(const std::string &str) {
-    std::string result = str;
-    while (!result.empty() && (result[0] == ' ' || result[0] == '\t')) {
-        result = result.substr(1, result.length());
+constexpr TransitionTable createTransitions() {
+    TransitionTable result = {};
+    for (auto &row : result) {
+        for (auto &next : row) {
+            next = State::STOP;
+        }
     }
+    auto set = [&result](State from, CharacterClass characterClass, State to) {
+        result[static_cast<std::size_t>(from)][static_cast<std::size_t>(characterClass)] = to;
+    };
+    auto setAllExcept = [&result](State from, CharacterClass except1, CharacterClass except2, State to) {
+        for (std::size_t i = 0; i < NUM_CHARACTER_CLASSES; i++) {
+            if (i != static_cast<std::size_t>(except1) && i != static_cast<std::size_t>(except2)) {
+                result[static_cast<std::size_t>(from)][i] = to;
+            }
+        }
+    };
+
+    set(State::START, CharacterClass::LETTER, State::IDENTIFIER);
+    set(State::START, CharacterClass::DIGIT, State::INTEGER);
+    set(State::START, CharacterClass::QUOTE, State::STRING);
+    set(State::START, CharacterClass::HASH, State::COMMENT);
+    set(State::START, CharacterClass::NEW_LINE, State::NEW_LINE_END);
+    set(State::START, CharacterClass::OPERATOR, State::OPERATOR_END);
+    set(State::START, CharacterClass::DOT, State::OPERATOR_END);
+    set(State::START, CharacterClass::EQUALS, State::COMPARISON);
+    set(State::START, CharacterClass::COMPARISON, State::COMPARISON);
+
+    set(State::IDENTIFIER, CharacterClass::LETTER, State::IDENTIFIER);
+    set(State::IDENTIFIER, CharacterClass::DIGIT, State::IDENTIFIER);
+
+    set(State::INTEGER, CharacterClass::DIGIT, State::INTEGER);
+    set(State::INTEGER, CharacterClass::DOT, State::INTEGER_DOT);
+    set(State::INTEGER_DOT, CharacterClass::DIGIT, State::FLOAT);
+    set(State::FLOAT, CharacterClass::DIGIT, State::FLOAT);
+
+    setAllExcept(State::STRING, CharacterClass::QUOTE, CharacterClass::NEW_LINE, State::STRING);
+    set(State::STRING, CharacterClass::QUOTE, State::STRING_END);
+
+    // NOTE comments include the trailing line break
+    setAllExcept(State::COMMENT, CharacterClass::NEW_LINE, CharacterClass::NEW_LINE, State::COMMENT);
+    set(State::COMMENT, CharacterClass::NEW_LINE, State::COMMENT_END);
+
+    set(State::COMPARISON, CharacterClass::EQUALS, State::COMPARISON_EQUALS);
     return result;
 }
 
+constexpr std::array<Token::TokenType, NUM_STATES> createAcceptingStates() {
+    std::array<Token::TokenType, NUM_STATES> result = {};
+    for (auto &type : result) {
+        type = Token::INVALID;
+    }
+    result[static_cast<std::size_t>(State::IDENTIFIER)] = Token::IDENTIFIER;
+    result[static_cast<std::size_t>(State::INTEGER)] = Token::INTEGER;
+    result[static_cast<std::size_t>(State::FLOAT)] = Token::FLOAT;
+    result[static_cast<std::size_t>(State::STRING_END)] = Token::STRING;
+    result[static_cast<std::size_t>(State::COMMENT)] = Token::COMMENT;
+    result[static_cast<std::size_t>(State::COMMENT_END)] = Token::COMMENT;
+    result[static_cast<std::size_t>(State::NEW_LINE_END)] = Token::NEW_LINE;
+    return result;
+}
+
+constexpr TokenTypeTable createOneCharTokens() {
+    TokenTypeTable result = {};
+    for (auto &type : result) {
+        type = Token::INVALID;
+    }
+    result['('] = Token::LEFT_PARAN;
+    result[')'] = Token::RIGHT_PARAN;
+    result['{'] = Token::LEFT_CURLY_BRACE;
+    result['}'] = Token::RIGHT_CURLY_BRACE;
+    result['['] = Token::LEFT_BRACKET;
+    result[']'] = Token::RIGHT_BRACKET;
+    result['='] = Token::SINGLE_EQUALS;
+    result['+'] = Token::PLUS;
+    result['-'] = Token::MINUS;
+    result['*'] = Token::STAR;
+    result['/'] = Token::DIV;
+    result[','] = Token::COMMA;
+    result[';'] = Token::SEMICOLON;
+    result['<'] = Token::LESS_THAN;
+    result['>'] = Token::GREATER_THAN;
+    result['.'] = Token::DOT;
+    return result;
+}
+
+constexpr TokenTypeTable createTwoCharTokens() {
+    // indexed by the first character, the second character is always '='
+    TokenTypeTable result = {};
+    for (auto &type : result) {
+        type = Token::INVALID;
+    }
+    result['!'] = Token::NOT_EQUALS;
+    result['='] = Token::DOUBLE_EQUALS;
+    result['>'] = Token::GREATER_EQUALS;
+    result['<'] = Token::LESS_EQUALS;
+    return result;
+}
+
+constexpr CharacterClassTable CHARACTER_CLASSES = createCharacterClasses();
+constexpr TransitionTable TRANSITIONS = createTransitions();
+constexpr std::array<Token::TokenType, NUM_STATES> ACCEPTING_STATES = createAcceptingStates();
+constexpr TokenTypeTable ONE_CHAR_TOKENS = createOneCharTokens();
+constexpr TokenTypeTable TWO_CHAR_TOKENS = createTwoCharTokens();
+
+inline CharacterClass classOf(char c) { return CHARACTER_CLASSES[static_cast<unsigned char>(c)]; }
+
+inline State transition(State state, char c) {
+    return TRANSITIONS[static_cast<std::size_t>(state)][static_cast<std::size_t>(classOf(c))];
+}
+
+inline Token::TokenType acceptedTokenType(State state, char firstChar) {
+    switch (state) {
+    case State::OPERATOR_END:
+    case State::COMPARISON:
+        return ONE_CHAR_TOKENS[static_cast<unsigned char>(firstChar)];
+    case State::COMPARISON_EQUALS:
+        return TWO_CHAR_TOKENS[static_cast<unsigned char>(firstChar)];
+    default:
+        return ACCEPTING_STATES[static_cast<std::size_t>(state)];
+    }
+}
+
+} // namespace
+
 Token Lexer::getToken() {
-    std::string previousWord = currentWord;
+    while (nextLexedToken >= lexedTokens.size() && !pendingChunks.empty()) {
+        auto chunk = pendingChunks.front().get();
+        log.append(chunk.logOutput);
+        lexedTokens = std::move(chunk.tokens);
+        nextLexedToken = 0;
+        pendingChunks.pop_front();
+    }
+
+    Token token = {};
+    if (nextLexedToken < lexedTokens.size()) {
+        token = lexedTokens[nextLexedToken++];
+    } else if (mode == Mode::REGEX) {
+        token = getTokenRegex();
+    } else {
+        token = getTokenTableDriven();
+    }
+
+    // interning happens here, in token order, so that symbol ids do not depend on how the code has been lexed
+    if (token.type == Token::IDENTIFIER && symbols != nullptr) {
+        token.symbol = symbols->intern(token.content);
+    }
+    return token;
+}
+
+Lexer::~Lexer() {
+    // the chunks point into the buffer of the CodeProvider, which might not outlive the lexer
+    for (auto &chunk : pendingChunks) {
+        chunk.wait();
+    }
+}
+
+void Lexer::lexInParallel(ThreadPool &threadPool, std::size_t chunkSize) {
+    if (mode != Mode::TABLE_DRIVEN || !currentWord.empty() || !pendingChunks.empty()) {
+        return;
+    }
+
+    auto optionalCode = codeProvider->getRemainingCode();
+    if (!optionalCode.has_value()) {
+        return;
+    }
+
+    const auto chunks = splitIntoChunks(optionalCode.value(), chunkSize);
+    if (chunks.size() < 2 || threadPool.size() < 2) {
+        // not worth the effort, just continue lexing sequentially
+        remainingCodeProvider = std::make_unique<BufferCodeProvider>(optionalCode.value());
+        codeProvider = remainingCodeProvider.get();
+        return;
+    }
+
+    for (const auto &chunk : chunks) {
+        pendingChunks.push_back(threadPool.submit([chunkLog = log, chunk]() mutable {
+            // the logger of the lexer might write into a stream that is not thread safe
+            auto logOutput = std::ostringstream();
+            chunkLog.setOutput(&logOutput);
+            auto chunkCodeProvider = BufferCodeProvider(chunk);
+            auto chunkLexer = Lexer(&chunkCodeProvider, chunkLog, Mode::TABLE_DRIVEN);
+            std::vector<Token> tokens = {};
+            // rough estimate to avoid most of the reallocations
+            tokens.reserve(chunk.size() / 4);
+            while (true) {
+                auto token = chunkLexer.getToken();
+                if (token.type == Token::INVALID && token.content.empty()) {
+                    // end of the chunk
+                    break;
+                }
+                tokens.push_back(token);
+            }
+            return LexedChunk{std::move(tokens), logOutput.str()};
+        }));
+    }
+
+    LOG_DEBUG(log, "Lexing " + std::to_string(chunks.size()) + " chunks in parallel");
+}
+
+Token Lexer::getTokenTableDriven() {
+    while (true) {
+        while (position < currentWord.size() && classOf(currentWord[position]) == CharacterClass::WHITESPACE) {
+            position++;
+        }
+        if (position < currentWord.size()) {
+            break;
+        }
+
+        auto optionalCode = codeProvider->getMoreCode();
+        if (!optionalCode.has_value()) {
+            currentWord = {};
+            position = 0;
+            return {Token::INVALID, ""};
+        }
+        currentWord = optionalCode.value();
+        position = 0;
+    }
+
+    // maximal munch: remember the last accepting state we went through
+    const std::size_t start = position;
+    const char firstChar = currentWord[start];
+    auto state = State::START;
+    auto acceptedType = Token::INVALID;
+    std::size_t acceptedEnd = start;
+    for (std::size_t i = start; i < currentWord.size(); i++) {
+        state = transition(state, currentWord[i]);
+        if (state == State::STOP) {
+            break;
+        }
+
+        const auto type = acceptedTokenType(state, firstChar);
+        if (type != Token::INVALID) {
+            acceptedType = type;
+            acceptedEnd = i + 1;
+        }
+    }
+
+    if (acceptedType == Token::INVALID) {
+        std::string_view invalidToken;
+        auto nextSpace = currentWord.find(' ', start);
+        if (nextSpace == std::string_view::npos) {
+            invalidToken = currentWord.substr(start);
+            position = currentWord.size();
+        } else {
+            invalidToken = currentWord.substr(start, nextSpace - start);
+            position = nextSpace + 1;
+        }
+
+        LOG_DEBUG(log, "Found an invalid token: '" + std::string(invalidToken) + "'");
+        return {Token::INVALID, invalidToken};
+    }
+
+    position = acceptedEnd;
+    auto content = currentWord.substr(start, acceptedEnd - start);
+    if (acceptedType == Token::IDENTIFIER) {
+        acceptedType = keywords::lookup(content);
+    }
+    return {acceptedType, content};
+}
+
+Token Lexer::getTokenRegex() {
+    std::string_view previousWord = currentWord;
     while (true) {
         if (currentWord.empty()) {
             auto optionalCode = codeProvider->getMoreCode();
@@ -82,7 +534,7 @@ Token Lexer::getToken() {
         }
 
         currentWord = removeLeadingWhitespace(currentWord);
-        log.debug("Current word: '" + currentWord + "'");
+        LOG_DEBUG(log, "Current word: '" + std::string(currentWord) + "'");
 
         auto floatToken = matchRegex("^[0-9]+\\.[0-9]+", Token::FLOAT);
         if (floatToken.has_value()) {
@@ -138,9 +590,9 @@ Token Lexer::getToken() {
         previousWord = currentWord;
     }
 
-    std::string invalidToken;
+    std::string_view invalidToken;
     auto nextSpace = currentWord.find(' ');
-    if (nextSpace == std::string::npos) {
+    if (nextSpace == std::string_view::npos) {
         invalidToken = currentWord;
         currentWord = "";
     } else {
@@ -149,16 +601,16 @@ Token Lexer::getToken() {
     }
 
     if (!invalidToken.empty()) {
-        log.debug("Found an invalid token: '" + invalidToken + "'");
+        LOG_DEBUG(log, "Found an invalid token: '" + std::string(invalidToken) + "'");
     }
     return {Token::INVALID, invalidToken};
 }
 
 std::optional<Token> Lexer::matchRegex(const std::string &regex, Token::TokenType tokenType) {
     std::regex re(regex);
-    auto itr = std::sregex_iterator(currentWord.begin(), currentWord.end(), re);
-    if (itr != std::sregex_iterator()) {
-        auto content = static_cast<std::string>((*itr).str());
+    auto itr = std::cregex_iterator(currentWord.data(), currentWord.data() + currentWord.size(), re);
+    if (itr != std::cregex_iterator()) {
+        auto content = currentWord.substr(itr->position(), itr->length());
         Token token = {tokenType, content};
         return std::optional<Token>(token);
     }
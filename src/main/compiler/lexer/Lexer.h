@@ -1,67 +1,154 @@
 #pragma once
 
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
-#include <filesystem>
 
 #include "../Logger.h"
 #include "Token.h"
 
+/**
+ * Hands out the source code of a module piece by piece (usually line by line).
+ * The returned views have to stay valid for the whole lifetime of the CodeProvider, since tokens point into them.
+ */
 class CodeProvider {
   public:
     virtual ~CodeProvider() = default;
 
-    virtual std::optional<std::string> getMoreCode() = 0;
+    virtual std::optional<std::string_view> getMoreCode() = 0;
+
+    /**
+     * Hands out all the code that has not been handed out yet in one piece (including line breaks).
+     * Only providers that keep the whole module in one buffer support this.
+     */
+    virtual std::optional<std::string_view> getRemainingCode() { return {}; }
 };
 
+/**
+ * Maps the whole file into memory once and then returns one line after the other (including the line break).
+ */
 class FileCodeProvider : public CodeProvider {
   public:
     explicit FileCodeProvider(std::filesystem::path absoluteFilePath) : fileName(std::move(absoluteFilePath)) {}
+    ~FileCodeProvider() override;
+
+    FileCodeProvider(const FileCodeProvider &) = delete;
+    FileCodeProvider &operator=(const FileCodeProvider &) = delete;
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
+    std::optional<std::string_view> getRemainingCode() override;
 
   private:
     const std::filesystem::path fileName;
     bool fileHasBeenRead = false;
-    std::vector<std::string> lines = {};
+    std::string_view code = {};
+    std::size_t position = 0;
+
+#ifdef WIN32
+    std::string fileContent = {};
+#else
+    void *mappedMemory = nullptr;
+    std::size_t mappedSize = 0;
+#endif
+
+    void readFile();
+};
+
+/**
+ * Returns a buffer that is owned by someone else line by line (including the line breaks).
+ */
+class BufferCodeProvider : public CodeProvider {
+  public:
+    explicit BufferCodeProvider(std::string_view code) : code(code) {}
+
+    std::optional<std::string_view> getMoreCode() override;
+    std::optional<std::string_view> getRemainingCode() override;
+
+  private:
+    std::string_view code;
+    std::size_t position = 0;
 };
 
 class StringCodeProvider : public CodeProvider {
   public:
-    explicit StringCodeProvider(std::vector<std::string> lines, bool addLineBreaks)
-        : lines(std::move(lines)), addLineBreaks(addLineBreaks) {}
+    explicit StringCodeProvider(std::vector<std::string> lines, bool addLineBreaks);
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
 
   private:
     std::vector<std::string> lines = {};
-    bool addLineBreaks = false;
+    std::size_t nextLine = 0;
 };
 
 class ByteCodeProvider : public CodeProvider {
   public:
     explicit ByteCodeProvider(const char *data, const long size) : data(data), size(size) {}
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
 
   private:
     const char *data;
     long size;
 };
 
+class ThreadPool;
+
 class Lexer {
   public:
-    explicit Lexer(CodeProvider *codeProvider, const Logger &logger) : codeProvider(codeProvider), log(logger){};
+    enum class Mode {
+        /// single pass scanner driven by a character class and a state transition table
+        TABLE_DRIVEN,
+        /// the original scanner, which matches every token with regular expressions
+        REGEX,
+    };
+
+    explicit Lexer(CodeProvider *codeProvider, const Logger &logger, Mode mode = Mode::TABLE_DRIVEN,
+                   SymbolTable *symbols = nullptr)
+        : codeProvider(codeProvider), log(logger), mode(mode), symbols(symbols){};
+    Lexer(Lexer &&) = default;
+    ~Lexer();
 
     Token getToken();
 
+    /**
+     * Splits the remaining code into chunks of whole lines and lexes them on the thread pool. getToken() hands out the
+     * tokens of the chunks in order, as soon as the respective chunk has been lexed. The tokens are identical to the
+     * ones the sequential lexer would have produced.
+     * Has to be called before the first token is requested and does nothing, if the CodeProvider cannot hand out its
+     * remaining code in one piece.
+     */
+    void lexInParallel(ThreadPool &threadPool, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
   private:
-    std::string currentWord;
+    std::string_view currentWord;
+    std::size_t position = 0;
     CodeProvider *codeProvider;
     const Logger &log;
+    Mode mode;
+    SymbolTable *symbols;
+
+    struct LexedChunk {
+        std::vector<Token> tokens = {};
+        /// every chunk is lexed with a logger of its own, the messages are printed once the chunk is consumed
+        std::string logOutput = {};
+    };
+    std::deque<std::future<LexedChunk>> pendingChunks = {};
+    std::vector<Token> lexedTokens = {};
+    std::size_t nextLexedToken = 0;
+    // takes over the remaining code, if it was too small to be split up
+    std::unique_ptr<CodeProvider> remainingCodeProvider = nullptr;
+
+    Token getTokenTableDriven();
+    Token getTokenRegex();
 
     std::optional<Token> matchRegex(const std::string &regex, Token::TokenType tokenType);
     std::optional<Token> matchOneCharToken();
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+
+#include "../SymbolTable.h"
 
 struct Token {
     enum TokenType {
@@ -49,7 +52,10 @@ struct Token {
     };
 
     TokenType type;
-    std::string content;
+    /// points into the buffer of the CodeProvider that the token has been created from
+    std::string_view content;
+    /// interned name of IDENTIFIER tokens, if the lexer has been given a SymbolTable
+    SymbolId symbol = NO_SYMBOL;
 };
 
 std::string to_string(Token::TokenType type);
@@ -5,13 +5,13 @@ IfStatementNode *Parser::parseIf(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing if statement");
+    LOG_DEBUG(log, indent(level) + "parsing if statement");
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
     auto *condition = parseExpression(level + 1);
     if (condition == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -25,7 +25,7 @@ IfStatementNode *Parser::parseIf(int level) {
         currentTokenIdx++;
         elseBody = parseScope(level + 1);
         if (elseBody == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
         if (elseBody->children.empty()) {
@@ -33,26 +33,26 @@ IfStatementNode *Parser::parseIf(int level) {
         }
     }
 
-    return tree.createIf(condition, ifBody, elseBody);
+    return tree->createIf(condition, ifBody, elseBody);
 }
 
 ForStatementNode *Parser::parseFor(int level) {
     if (!currentTokenIs(Token::FOR)) {
         return nullptr;
     }
-    log.debug(indent(level) + "parsing for statement");
+    LOG_DEBUG(log, indent(level) + "parsing for statement");
 
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
     auto *init = parseStatement(level + 1);
     if (init == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     if (!currentTokenIs(Token::SEMICOLON)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -60,12 +60,12 @@ ForStatementNode *Parser::parseFor(int level) {
 
     auto *condition = parseExpression(level + 1);
     if (condition == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     if (!currentTokenIs(Token::SEMICOLON)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -73,17 +73,17 @@ ForStatementNode *Parser::parseFor(int level) {
 
     auto *update = parseStatement(level + 1);
     if (update == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     auto *body = parseScope(level + 1);
     if (body == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    return tree.createFor(init, condition, update, body);
+    return tree->createFor(init, condition, update, body);
 }
 
 StatementNode *Parser::parseReturnStatement(int level) {
@@ -91,15 +91,15 @@ StatementNode *Parser::parseReturnStatement(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing return statement");
+    LOG_DEBUG(log, indent(level) + "parsing return statement");
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
     auto *expression = parseExpression(level + 1);
     if (expression == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    return tree.createStatement(expression, true);
+    return tree->createStatement(expression, true);
 }
@@ -1,76 +1,82 @@
 #include "Parser.h"
 
-MemberAccessNode *Parser::parseMemberAccess(int level) {
+#include <array>
+
+namespace {
+
+struct BinaryOperator {
+    /// operators with a higher precedence bind more tightly, 0 means that the token is not a binary operator
+    int precedence = 0;
+    ast::BinaryOperationType type = ast::BinaryOperationType::ADDITION;
+};
+
+constexpr std::array<BinaryOperator, Token::END_OF_FILE + 1> createBinaryOperatorTable() {
+    std::array<BinaryOperator, Token::END_OF_FILE + 1> table = {};
+    table[Token::AND] = {1, ast::BinaryOperationType::AND};
+    table[Token::OR] = {1, ast::BinaryOperationType::OR};
+    table[Token::DOUBLE_EQUALS] = {2, ast::BinaryOperationType::EQUALS};
+    table[Token::NOT_EQUALS] = {2, ast::BinaryOperationType::NOT_EQUALS};
+    table[Token::LESS_THAN] = {3, ast::BinaryOperationType::LESS_THAN};
+    table[Token::LESS_EQUALS] = {3, ast::BinaryOperationType::LESS_EQUALS};
+    table[Token::GREATER_THAN] = {3, ast::BinaryOperationType::GREATER_THAN};
+    table[Token::GREATER_EQUALS] = {3, ast::BinaryOperationType::GREATER_EQUALS};
+    table[Token::PLUS] = {4, ast::BinaryOperationType::ADDITION};
+    table[Token::MINUS] = {4, ast::BinaryOperationType::SUBTRACTION};
+    table[Token::STAR] = {5, ast::BinaryOperationType::MULTIPLICATION};
+    table[Token::DIV] = {5, ast::BinaryOperationType::DIVISION};
+    return table;
+}
+
+/// all binary operators are left associative
+constexpr std::array<BinaryOperator, Token::END_OF_FILE + 1> BINARY_OPERATORS = createBinaryOperatorTable();
+
+} // namespace
+
+AstNode *Parser::parseVariableOrMemberAccess(int level) {
     auto beforeTokenIdx = currentTokenIdx;
     auto *lastNode = AST_NODE(parseVariable(level + 1));
     if (lastNode == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
         return nullptr;
     }
 
-    bool foundAtLeastOneDot = false;
-    while (true) {
-        if (!currentTokenIs(Token::DOT)) {
-            break;
-        }
-        foundAtLeastOneDot = true;
-
+    while (currentTokenIs(Token::DOT)) {
         currentTokenIdx++;
 
         auto *other = parseVariable(level + 1);
         if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
 
-        lastNode = AST_NODE(tree.createMemberAccess(lastNode, AST_NODE(other)));
-    }
-
-    if (!foundAtLeastOneDot) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
+        lastNode = AST_NODE(tree->createMemberAccess(lastNode, AST_NODE(other)));
     }
 
-    return &lastNode->member_access;
+    return lastNode;
 }
 
 AstNode *Parser::parsePrimary(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *memberAccess = parseMemberAccess(level + 1);
-    if (memberAccess != nullptr) {
-        return AST_NODE(memberAccess);
-    }
-
-    auto *functionCall = parseFunctionCall(level + 1);
-    if (functionCall != nullptr) {
-        return AST_NODE(functionCall);
-    }
-
-    auto *variable = parseVariable(level + 1);
-    if (variable != nullptr) {
-        return AST_NODE(variable);
-    }
-
-    auto *literal = parseLiteral(level + 1);
-    if (literal != nullptr) {
-        return AST_NODE(literal);
+    if (currentTokenIs(Token::IDENTIFIER)) {
+        if (nextTokenIs(Token::LEFT_PARAN)) {
+            return AST_NODE(parseFunctionCall(level + 1));
+        }
+        return parseVariableOrMemberAccess(level + 1);
     }
 
     if (!currentTokenIs(Token::LEFT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
+        return AST_NODE(parseLiteral(level + 1));
     }
 
+    auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
     auto *expression = parseExpression(level + 1);
     if (expression == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     if (!currentTokenIs(Token::RIGHT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -94,174 +100,48 @@ AstNode *Parser::parseUnary(int level) {
 
     auto *child = parseUnary(level + 1);
     if (child == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    return AST_NODE(tree.createUnaryOperation(operationType, child));
+    return AST_NODE(tree->createUnaryOperation(operationType, child));
 }
 
-AstNode *Parser::parseFactor(int level) {
+AstNode *Parser::parseBinaryOperation(int minPrecedence, int level) {
     auto beforeTokenIdx = currentTokenIdx;
-    auto *lastUnary = parseUnary(level + 1);
-    if (lastUnary == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+    auto *left = parseUnary(level + 1);
+    if (left == nullptr) {
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::STAR)) {
-            operationType = ast::BinaryOperationType::MULTIPLICATION;
-        } else if (currentTokenIs(Token::DIV)) {
-            operationType = ast::BinaryOperationType::DIVISION;
-        } else {
+        const Token *token = tokenAt(currentTokenIdx);
+        if (token == nullptr) {
             break;
         }
 
-        currentTokenIdx++;
-
-        auto *other = parseUnary(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastUnary = AST_NODE(tree.createBinaryOperation(operationType, lastUnary, other));
-    }
-
-    return lastUnary;
-}
-
-AstNode *Parser::parseTerm(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastFactor = parseFactor(level + 1);
-    if (lastFactor == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::PLUS)) {
-            operationType = ast::BinaryOperationType::ADDITION;
-        } else if (currentTokenIs(Token::MINUS)) {
-            operationType = ast::BinaryOperationType::SUBTRACTION;
-        } else {
+        const auto &binaryOperator = BINARY_OPERATORS[token->type];
+        if (binaryOperator.precedence == 0 || binaryOperator.precedence < minPrecedence) {
             break;
         }
 
         currentTokenIdx++;
 
-        auto *other = parseFactor(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+        // the right operand only takes operators that bind more tightly, which makes the operator left associative
+        auto *right = parseBinaryOperation(binaryOperator.precedence + 1, level + 1);
+        if (right == nullptr) {
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
 
-        lastFactor = AST_NODE(tree.createBinaryOperation(operationType, lastFactor, other));
+        left = AST_NODE(tree->createBinaryOperation(binaryOperator.type, left, right));
     }
 
-    return lastFactor;
-}
-
-AstNode *Parser::parseComparison(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastTerm = parseTerm(level + 1);
-    if (lastTerm == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::LESS_THAN)) {
-            operationType = ast::BinaryOperationType::LESS_THAN;
-        } else if (currentTokenIs(Token::LESS_EQUALS)) {
-            operationType = ast::BinaryOperationType::LESS_EQUALS;
-        } else if (currentTokenIs(Token::GREATER_THAN)) {
-            operationType = ast::BinaryOperationType::GREATER_THAN;
-        } else if (currentTokenIs(Token::GREATER_EQUALS)) {
-            operationType = ast::BinaryOperationType::GREATER_EQUALS;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseTerm(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastTerm = AST_NODE(tree.createBinaryOperation(operationType, lastTerm, other));
-    }
-
-    return lastTerm;
-}
-
-AstNode *Parser::parseEquality(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastComparison = parseComparison(level + 1);
-    if (lastComparison == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::DOUBLE_EQUALS)) {
-            operationType = ast::BinaryOperationType::EQUALS;
-        } else if (currentTokenIs(Token::NOT_EQUALS)) {
-            operationType = ast::BinaryOperationType::NOT_EQUALS;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseComparison(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastComparison = AST_NODE(tree.createBinaryOperation(operationType, lastComparison, other));
-    }
-
-    return lastComparison;
+    return left;
 }
 
 AstNode *Parser::parseExpression(int level) {
-    log.debug(indent(level) + "parsing expression node");
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastEquality = parseEquality(level + 1);
-    if (lastEquality == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::AND)) {
-            operationType = ast::BinaryOperationType::AND;
-        } else if (currentTokenIs(Token::OR)) {
-            operationType = ast::BinaryOperationType::OR;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseEquality(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastEquality = AST_NODE(tree.createBinaryOperation(operationType, lastEquality, other));
-    }
-
-    return lastEquality;
+    LOG_DEBUG(log, indent(level) + "parsing expression node");
+    return parseBinaryOperation(0, level);
 }
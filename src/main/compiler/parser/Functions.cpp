@@ -6,23 +6,23 @@ CallNode *Parser::parseFunctionCall(int level) {
     }
 
     auto beforeTokenIdx = currentTokenIdx;
-    std::string name = currentTokenContent();
+    SymbolId name = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     currentTokenIdx++;
 
-    log.debug(indent(level) + "parsing call node");
+    LOG_DEBUG(log, indent(level) + "parsing call node");
 
     std::vector<AstNode *> params = {};
     while (!currentTokenIs(Token::RIGHT_PARAN)) {
         auto *expression = parseExpression(level + 1);
         if (expression == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
         params.push_back(expression);
@@ -32,13 +32,13 @@ CallNode *Parser::parseFunctionCall(int level) {
     }
 
     if (!currentTokenIs(Token::RIGHT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     currentTokenIdx++;
 
-    return tree.createCall(name, params);
+    return tree->createCall(name, params);
 }
 
 FunctionNode *Parser::parseFunction(int level) {
@@ -48,24 +48,24 @@ FunctionNode *Parser::parseFunction(int level) {
     }
 
     if (!currentTokenIs(Token::FUN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::IDENTIFIER)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing function node");
+    LOG_DEBUG(log, indent(level) + "parsing function node");
 
-    std::string functionName = currentTokenContent();
+    SymbolId functionName = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -80,7 +80,7 @@ FunctionNode *Parser::parseFunction(int level) {
     } while (currentTokenIs(Token::COMMA));
 
     if (!currentTokenIs(Token::RIGHT_PARAN)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -93,5 +93,5 @@ FunctionNode *Parser::parseFunction(int level) {
     }
 
     auto *body = parseScope(level + 1);
-    return tree.createFunction(functionName, returnType, params, body);
+    return tree->createFunction(functionName, returnType, params, body);
 }
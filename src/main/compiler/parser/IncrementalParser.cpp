@@ -0,0 +1,200 @@
+#include "IncrementalParser.h"
+
+#include "Parser.h"
+
+#include <algorithm>
+
+namespace {
+
+/// returns the position after the line break that ends the line containing position
+std::size_t endOfLine(const std::string &code, std::size_t position) {
+    if (position > 0 && code[position - 1] == '\n') {
+        // comments include their line break
+        return position;
+    }
+    auto lineBreak = code.find('\n', position);
+    if (lineBreak == std::string::npos) {
+        return code.size();
+    }
+    return lineBreak + 1;
+}
+
+} // namespace
+
+std::string IncrementalParser::getCode(const Module *module) {
+    std::string result;
+    for (const auto &segment : module->segments) {
+        result += segment->code;
+    }
+    return result;
+}
+
+bool IncrementalParser::run(Module *module) {
+    std::string code;
+    auto *codeProvider = module->getCodeProvider();
+    auto remainingCode = codeProvider->getRemainingCode();
+    if (remainingCode.has_value()) {
+        code = std::string(remainingCode.value());
+    } else {
+        for (auto line = codeProvider->getMoreCode(); line.has_value(); line = codeProvider->getMoreCode()) {
+            code += line.value();
+        }
+    }
+
+    auto segments = parseSegments(module, code);
+    if (!segments.has_value()) {
+        return false;
+    }
+
+    module->segments = std::move(segments.value());
+    updateRoot(module);
+
+    reparsedBytes = code.size();
+    return true;
+}
+
+bool IncrementalParser::applyEdit(Module *module, std::size_t begin, std::size_t end, std::string_view replacement) {
+    auto &segments = module->segments;
+    if (segments.empty() || begin > end) {
+        return false;
+    }
+
+    std::vector<std::size_t> segmentBegins = {};
+    segmentBegins.reserve(segments.size());
+    std::size_t codeSize = 0;
+    for (const auto &segment : segments) {
+        segmentBegins.push_back(codeSize);
+        codeSize += segment->code.size();
+    }
+    if (end > codeSize) {
+        log.error("Edit [" + std::to_string(begin) + ", " + std::to_string(end) + ") is outside of the module");
+        return false;
+    }
+
+    auto first = std::upper_bound(segmentBegins.begin(), segmentBegins.end(), begin) - segmentBegins.begin() - 1;
+    auto last = first;
+    while (last + 1 < static_cast<int64_t>(segments.size()) && segmentBegins[last + 1] < end) {
+        last++;
+    }
+
+    std::string code;
+    for (auto i = first; i <= last; i++) {
+        code += segments[i]->code;
+    }
+    code.replace(begin - segmentBegins[first], end - begin, replacement);
+
+    // the edited lines have to end with a line break, otherwise the next line is part of them now
+    while (last + 1 < static_cast<int64_t>(segments.size()) && (code.empty() || code.back() != '\n')) {
+        last++;
+        code += segments[last]->code;
+    }
+
+    auto parsedSegments = parseSegments(module, code);
+    if (!parsedSegments.has_value() && (first > 0 || last + 1 < static_cast<int64_t>(segments.size()))) {
+        // the edit might only make sense together with the rest of the module (e.g. removing an opening brace)
+        LOG_DEBUG(log, "Failed to re-parse the edited statements, re-parsing the whole module");
+        first = 0;
+        last = static_cast<int64_t>(segments.size()) - 1;
+        code = getCode(module);
+        code.replace(begin, end - begin, replacement);
+        parsedSegments = parseSegments(module, code);
+    }
+    if (!parsedSegments.has_value()) {
+        return false;
+    }
+
+    // the replaced statements are reused by the nodes of the next edit
+    for (auto i = first; i <= last; i++) {
+        for (auto *statement : segments[i]->statements) {
+            module->ast.release(statement);
+        }
+    }
+    segments.erase(segments.begin() + first, segments.begin() + last + 1);
+    segments.insert(segments.begin() + first, std::make_move_iterator(parsedSegments->begin()),
+                    std::make_move_iterator(parsedSegments->end()));
+    updateRoot(module);
+
+    reparsedBytes = code.size();
+    return true;
+}
+
+std::optional<std::vector<std::unique_ptr<SourceSegment>>>
+IncrementalParser::parseSegments(Module *module, const std::string &code) {
+    auto codeProvider = BufferCodeProvider(code);
+    auto lexer = Lexer(&codeProvider, log, Lexer::Mode::TABLE_DRIVEN, &symbols);
+    auto parser = Parser(log, lexer, symbols);
+    std::vector<Token> tokens = {};
+    std::vector<Parser::ParsedStatement> statements = {};
+    auto releaseStatements = [module, &statements]() {
+        for (const auto &statement : statements) {
+            module->ast.release(statement.node);
+        }
+    };
+    if (!parser.parseStatements(module, tokens, statements)) {
+        releaseStatements();
+        return {};
+    }
+
+    for (const auto &token : tokens) {
+        if (token.type == Token::INVALID && !token.content.empty()) {
+            // the lexer stops at invalid tokens, everything after this token would get lost
+            log.error("Invalid token: " + std::string(token.content));
+            releaseStatements();
+            return {};
+        }
+    }
+
+    auto offsetOf = [&code](const Token &token) -> std::size_t { return token.content.data() - code.data(); };
+
+    // statements that share a line end up in the same segment
+    std::vector<std::unique_ptr<SourceSegment>> result = {};
+    std::size_t segmentBegin = 0;
+    std::size_t tokenIdx = 0;
+    std::size_t statementIdx = 0;
+    do {
+        auto segment = std::make_unique<SourceSegment>();
+        std::size_t segmentEnd = code.size();
+        while (statementIdx < statements.size()) {
+            const auto &statement = statements[statementIdx];
+            if (!segment->statements.empty() && offsetOf(tokens[statement.firstToken]) >= segmentEnd) {
+                break;
+            }
+            const auto &lastToken = tokens[statement.endToken - 1];
+            segmentEnd = endOfLine(code, offsetOf(lastToken) + lastToken.content.size());
+            segment->statements.push_back(statement.node);
+            statementIdx++;
+        }
+        if (statementIdx == statements.size()) {
+            // trailing empty lines belong to the last segment
+            segmentEnd = code.size();
+        }
+
+        segment->code = code.substr(segmentBegin, segmentEnd - segmentBegin);
+        for (; tokenIdx < tokens.size(); tokenIdx++) {
+            auto token = tokens[tokenIdx];
+            if (token.type == Token::INVALID) {
+                continue;
+            }
+            auto offset = offsetOf(token);
+            if (offset >= segmentEnd) {
+                break;
+            }
+            token.content = std::string_view(segment->code.data() + (offset - segmentBegin), token.content.size());
+            segment->tokens.push_back(token);
+        }
+
+        result.push_back(std::move(segment));
+        segmentBegin = segmentEnd;
+    } while (statementIdx < statements.size());
+
+    return result;
+}
+
+void IncrementalParser::updateRoot(Module *module) {
+    std::vector<AstNode *> children = {};
+    for (const auto &segment : module->segments) {
+        children.insert(children.end(), segment->statements.begin(), segment->statements.end());
+    }
+    module->ast.setRootChildren(children);
+    module->ast.completed();
+}
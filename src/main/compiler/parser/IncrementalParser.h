@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../../Module.h"
+#include "../Logger.h"
+#include "../SymbolTable.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * Parses a module into SourceSegments and keeps them on the module. An edit only re-lexes the lines of the segments it
+ * touches and only re-parses the top level statements in those segments, all other tokens and subtrees are kept.
+ */
+class IncrementalParser {
+  public:
+    IncrementalParser(const Logger &logger, SymbolTable &symbols) : log(logger), symbols(symbols) {}
+
+    /// parses the whole code of the module, returns false if there was a syntax error
+    bool run(Module *module);
+
+    /**
+     * Replaces the bytes [begin, end) of the code of the module with replacement and re-parses the affected top level
+     * statements. Returns false and leaves the module untouched, if the edited code contains a syntax error.
+     */
+    bool applyEdit(Module *module, std::size_t begin, std::size_t end, std::string_view replacement);
+
+    /// number of bytes that had to be lexed and parsed again for the last edit
+    [[nodiscard]] std::size_t getReparsedBytes() const { return reparsedBytes; }
+
+    /// the current source code of the module
+    static std::string getCode(const Module *module);
+
+  private:
+    const Logger &log;
+    SymbolTable &symbols;
+    std::size_t reparsedBytes = 0;
+
+    std::optional<std::vector<std::unique_ptr<SourceSegment>>> parseSegments(Module *module, const std::string &code);
+    static void updateRoot(Module *module);
+};
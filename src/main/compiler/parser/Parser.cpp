@@ -1,18 +1,83 @@
 #include "Parser.h"
 
+#include <algorithm>
 #include <iostream>
 
-Token Parser::getNextToken() {
-    Token token = lexer.getToken();
+void Parser::getNextToken() {
+    const Token token = lexer.getToken();
     tokens.push_back(token);
-    return token;
+    lexedAllTokens = token.type == Token::INVALID;
+    maxWindowSize = std::max(maxWindowSize, tokens.size());
 }
 
-bool Parser::currentTokenIs(Token::TokenType tokenType) const {
-    return currentTokenIdx < tokens.size() && tokens[currentTokenIdx].type == tokenType;
+const Token *Parser::tokenAt(int idx) {
+    if (idx < windowStart) {
+        return nullptr;
+    }
+
+    while (!lexedAllTokens && idx >= windowStart + static_cast<int>(tokens.size())) {
+        getNextToken();
+    }
+
+    if (idx >= windowStart + static_cast<int>(tokens.size())) {
+        return nullptr;
+    }
+    return &tokens[idx - windowStart];
 }
 
-std::string Parser::currentTokenContent() const { return tokens[currentTokenIdx].content; }
+void Parser::releaseTokensBefore(int idx) {
+    if (mode != Mode::STREAMING) {
+        return;
+    }
+
+    while (windowStart < idx && !tokens.empty()) {
+        tokens.pop_front();
+        windowStart++;
+    }
+}
+
+void Parser::backtrack(int idx) {
+    backtrackedTokens += currentTokenIdx - idx;
+    currentTokenIdx = idx;
+}
+
+bool Parser::currentTokenIs(Token::TokenType tokenType) {
+    const Token *token = tokenAt(currentTokenIdx);
+    return token != nullptr && token->type == tokenType;
+}
+
+bool Parser::nextTokenIs(Token::TokenType tokenType) {
+    const Token *token = tokenAt(currentTokenIdx + 1);
+    return token != nullptr && token->type == tokenType;
+}
+
+std::string Parser::currentTokenContent() {
+    const Token *token = tokenAt(currentTokenIdx);
+    if (token == nullptr) {
+        return "";
+    }
+    return std::string(token->content);
+}
+
+SymbolId Parser::currentTokenSymbol() {
+    const Token *token = tokenAt(currentTokenIdx);
+    if (token == nullptr) {
+        return NO_SYMBOL;
+    }
+    if (token->symbol != NO_SYMBOL) {
+        return token->symbol;
+    }
+    // the lexer has not been given a symbol table
+    return symbols.intern(token->content);
+}
+
+SymbolId Parser::currentTokenString() {
+    const Token *token = tokenAt(currentTokenIdx);
+    if (token == nullptr || token->content.size() < 2) {
+        return NO_SYMBOL;
+    }
+    return symbols.intern(token->content.substr(1, token->content.size() - 2));
+}
 
 std::string Parser::indent(int level) {
     std::string result;
@@ -30,15 +95,14 @@ ImportNode *Parser::parseImport() {
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::STRING)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    std::string fileName = currentTokenContent();
-    fileName = fileName.substr(1, fileName.size() - 2);
+    auto fileName = currentTokenString();
 
     currentTokenIdx++;
-    return tree.createImport(fileName);
+    return tree->createImport(fileName);
 }
 
 VariableNode *Parser::parseVariable(int level) {
@@ -47,7 +111,7 @@ VariableNode *Parser::parseVariable(int level) {
     }
 
     auto beforeTokenIdx = currentTokenIdx;
-    std::string name = currentTokenContent();
+    SymbolId name = currentTokenSymbol();
 
     currentTokenIdx++;
 
@@ -57,22 +121,22 @@ VariableNode *Parser::parseVariable(int level) {
 
         expression = parseExpression(level + 1);
         if (expression == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
         if (!currentTokenIs(Token::RIGHT_BRACKET)) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
 
         currentTokenIdx++;
     }
 
-    return tree.createVariable(name, expression);
+    return tree->createVariable(name, expression);
 }
 
 VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
-    log.debug(indent(level) + "parsing variable definition node");
+    LOG_DEBUG(log, indent(level) + "parsing variable definition node");
 
     auto beforeTokenIdx = currentTokenIdx;
     if (currentTokenIs(Token::SIMPLE_DATA_TYPE)) {
@@ -81,35 +145,35 @@ VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
         currentTokenIdx++;
 
         if (currentTokenIs(Token::IDENTIFIER)) {
-            log.debug(indent(level) + "parsed variable definition with simple data type");
-            std::string variableName = currentTokenContent();
+            LOG_DEBUG(log, indent(level) + "parsed variable definition with simple data type");
+            SymbolId variableName = currentTokenSymbol();
             currentTokenIdx++;
-            return tree.createVariableDefinition(variableName, dataType, 0);
+            return tree->createVariableDefinition(variableName, dataType, 0);
         }
         if (currentTokenIs(Token::LEFT_BRACKET)) {
             currentTokenIdx++;
 
             auto *literal = parseLiteral(level + 1);
             if (literal == nullptr || literal->type != LiteralType::INTEGER) {
-                currentTokenIdx = beforeTokenIdx;
+                backtrack(beforeTokenIdx);
                 return nullptr;
             }
 
             if (!currentTokenIs(Token::RIGHT_BRACKET)) {
-                currentTokenIdx = beforeTokenIdx;
+                backtrack(beforeTokenIdx);
                 return nullptr;
             }
 
             currentTokenIdx++;
 
             if (!currentTokenIs(Token::IDENTIFIER)) {
-                currentTokenIdx = beforeTokenIdx;
+                backtrack(beforeTokenIdx);
                 return nullptr;
             }
 
-            std::string variableName = currentTokenContent();
+            SymbolId variableName = currentTokenSymbol();
             currentTokenIdx++;
-            return tree.createVariableDefinition(variableName, dataType, literal->i);
+            return tree->createVariableDefinition(variableName, dataType, literal->i);
         }
     } else if (currentTokenIs(Token::IDENTIFIER)) {
         auto dataType = ast::DataType(currentTokenContent());
@@ -117,17 +181,17 @@ VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
         currentTokenIdx++;
 
         if (!currentTokenIs(Token::IDENTIFIER)) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
 
-        log.debug(indent(level) + "parsed variable definition with simple data type");
-        std::string variableName = currentTokenContent();
+        LOG_DEBUG(log, indent(level) + "parsed variable definition with simple data type");
+        SymbolId variableName = currentTokenSymbol();
         currentTokenIdx++;
-        return tree.createVariableDefinition(variableName, dataType, 0);
+        return tree->createVariableDefinition(variableName, dataType, 0);
     }
 
-    log.debug(indent(level) + "failed to parse variable definition");
+    LOG_DEBUG(log, indent(level) + "failed to parse variable definition");
 
     return nullptr;
 }
@@ -136,7 +200,7 @@ SequenceNode *Parser::parseScope(int level) {
     if (!currentTokenIs(Token::LEFT_CURLY_BRACE)) {
         return nullptr;
     }
-    log.debug(indent(level) + "parsing scope");
+    LOG_DEBUG(log, indent(level) + "parsing scope");
 
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
@@ -149,62 +213,59 @@ SequenceNode *Parser::parseScope(int level) {
         }
 
         children.push_back(AST_NODE(statement));
+
+        // backtracking out of a completed statement only happens on the way to a syntax error, so the window does
+        // not have to grow with the size of the scope
+        releaseTokensBefore(currentTokenIdx);
     }
 
     if (!currentTokenIs(Token::RIGHT_CURLY_BRACE)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     currentTokenIdx++;
 
-    return tree.createSequence(children);
+    return tree->createSequence(children);
 }
 
 AstNode *Parser::parseAssignmentLeft(int level) {
-    auto *variableDefinitionNode = parseVariableDefinition(level + 1);
-    if (variableDefinitionNode != nullptr) {
-        return AST_NODE(variableDefinitionNode);
+    // a variable definition always starts with its type: "int a", "int[5] a" or "MyType a"
+    if (currentTokenIs(Token::SIMPLE_DATA_TYPE) || nextTokenIs(Token::IDENTIFIER)) {
+        return AST_NODE(parseVariableDefinition(level + 1));
     }
 
-    auto *memberAccess = parseMemberAccess(level + 1);
-    if (memberAccess != nullptr) {
-        return AST_NODE(memberAccess);
-    }
-
-    auto *variableNode = parseVariable(level + 1);
-    if (variableNode != nullptr) {
-        return AST_NODE(variableNode);
-    }
-
-    return nullptr;
+    return parseVariableOrMemberAccess(level + 1);
 }
 
-AssignmentNode *Parser::parseAssignment(int level) {
-    log.debug(indent(level) + "parsing assignment statement");
+AstNode *Parser::parseAssignmentOrVariableDefinition(int level) {
+    LOG_DEBUG(log, indent(level) + "parsing assignment statement");
     auto beforeTokenIdx = currentTokenIdx;
     auto *left = parseAssignmentLeft(level + 1);
     if (left == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
-    log.debug(indent(level) + "parsed assignment left");
+    LOG_DEBUG(log, indent(level) + "parsed assignment left");
 
     if (!currentTokenIs(Token::SINGLE_EQUALS)) {
-        currentTokenIdx = beforeTokenIdx;
+        if (left->type == ast::NodeType::VARIABLE_DEFINITION) {
+            return left;
+        }
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
     currentTokenIdx++;
 
     auto *right = parseExpression(level + 1);
     if (right == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsed assignment right");
+    LOG_DEBUG(log, indent(level) + "parsed assignment right");
 
-    return tree.createAssignment(left, right);
+    return AST_NODE(tree->createAssignment(left, right));
 }
 
 AssertNode *Parser::parseAssert(int level) {
@@ -212,17 +273,17 @@ AssertNode *Parser::parseAssert(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing assert statement");
+    LOG_DEBUG(log, indent(level) + "parsing assert statement");
 
     currentTokenIdx++;
 
     auto *expression = parseExpression(level + 1);
     if (expression == nullptr) {
-        currentTokenIdx--;
+        backtrack(currentTokenIdx - 1);
         return nullptr;
     }
 
-    return tree.createAssert(expression);
+    return tree->createAssert(expression);
 }
 
 CommentNode *Parser::parseComment(int /*level*/) {
@@ -230,123 +291,145 @@ CommentNode *Parser::parseComment(int /*level*/) {
         return nullptr;
     }
 
-    log.debug("parsed comment node");
+    LOG_DEBUG(log, "parsed comment node");
 
-    auto *result = tree.createComment(currentTokenContent());
+    auto *result = tree->createComment(symbols.intern(tokenAt(currentTokenIdx)->content));
     currentTokenIdx++;
     return result;
 }
 
 StatementNode *Parser::parseStatement(int level) {
-    log.debug(indent(level) + "parsing statement node");
+    LOG_DEBUG(log, indent(level) + "parsing statement node");
 
     while (currentTokenIs(Token::NEW_LINE)) {
         currentTokenIdx++;
     }
 
-    auto *commentNode = parseComment(level + 1);
-    if (commentNode != nullptr) {
-        return tree.createStatement(AST_NODE(commentNode), false);
-    }
-
-    auto *importNode = parseImport();
-    if (importNode != nullptr) {
-        return tree.createStatement(AST_NODE(importNode), false);
-    }
-
-    auto *typeNode = parseTypeDeclaration(level + 1);
-    if (typeNode != nullptr) {
-        return tree.createStatement(AST_NODE(typeNode), false);
-    }
-
-    auto *assertNode = parseAssert(level + 1);
-    if (assertNode != nullptr) {
-        return tree.createStatement(AST_NODE(assertNode), false);
-    }
-
-    auto *callNode = parseFunctionCall(level + 1);
-    if (callNode != nullptr) {
-        return tree.createStatement(AST_NODE(callNode), false);
-    }
-
-    auto *functionNode = parseFunction(level + 1);
-    if (functionNode != nullptr) {
-        return tree.createStatement(AST_NODE(functionNode), false);
-    }
-
-    auto *ifNode = parseIf(level + 1);
-    if (ifNode != nullptr) {
-        return tree.createStatement(AST_NODE(ifNode), false);
-    }
-
-    auto *forNode = parseFor(level + 1);
-    if (forNode != nullptr) {
-        return tree.createStatement(AST_NODE(forNode), false);
-    }
-
-    auto *assignmentNode = parseAssignment(level + 1);
-    if (assignmentNode != nullptr) {
-        return tree.createStatement(AST_NODE(assignmentNode), false);
+    const Token *token = tokenAt(currentTokenIdx);
+    if (token == nullptr) {
+        return nullptr;
     }
 
-    auto *variableDefinition = parseVariableDefinition(level + 1);
-    if (variableDefinition != nullptr) {
-        return tree.createStatement(AST_NODE(variableDefinition), false);
+    // the first token (and the second one for identifiers) determines the only rule that can match
+    AstNode *node = nullptr;
+    switch (token->type) {
+    case Token::COMMENT:
+        node = AST_NODE(parseComment(level + 1));
+        break;
+    case Token::IMPORT:
+        node = AST_NODE(parseImport());
+        break;
+    case Token::TYPE:
+        node = AST_NODE(parseTypeDeclaration(level + 1));
+        break;
+    case Token::ASSERT:
+        node = AST_NODE(parseAssert(level + 1));
+        break;
+    case Token::EXTERN:
+    case Token::FUN:
+        node = AST_NODE(parseFunction(level + 1));
+        break;
+    case Token::IF:
+        node = AST_NODE(parseIf(level + 1));
+        break;
+    case Token::FOR:
+        node = AST_NODE(parseFor(level + 1));
+        break;
+    case Token::RETURN:
+        return parseReturnStatement(level + 1);
+    case Token::IDENTIFIER:
+        if (nextTokenIs(Token::LEFT_PARAN)) {
+            node = AST_NODE(parseFunctionCall(level + 1));
+            break;
+        }
+        node = parseAssignmentOrVariableDefinition(level + 1);
+        break;
+    case Token::SIMPLE_DATA_TYPE:
+        node = parseAssignmentOrVariableDefinition(level + 1);
+        break;
+    default:
+        break;
     }
 
-    auto *returnStatement = parseReturnStatement(level + 1);
-    if (returnStatement != nullptr) {
-        return returnStatement;
+    if (node == nullptr) {
+        return nullptr;
     }
-
-    return nullptr;
+    return tree->createStatement(node, false);
 }
 
-void Parser::run(Module *module) {
+bool Parser::parseTopLevelStatements(std::vector<ParsedStatement> &statements) {
     while (true) {
-        const Token token = getNextToken();
-        if (token.type == Token::INVALID) {
-            break;
-        }
-    }
-
-    std::vector<AstNode *> children = {};
-    bool error = false;
-
-    while (currentTokenIdx < tokens.size()) {
-        auto token = tokens[currentTokenIdx];
-        if (token.type == Token::INVALID) {
-            error = currentTokenIdx != tokens.size() - 1;
+        const Token *token = tokenAt(currentTokenIdx);
+        if (token == nullptr || token->type == Token::INVALID) {
             break;
         }
 
-        if (token.type == Token::NEW_LINE) {
+        if (token->type == Token::NEW_LINE) {
             currentTokenIdx++;
+            releaseTokensBefore(currentTokenIdx);
             continue;
         }
 
+        const int firstTokenIdx = currentTokenIdx;
         auto *statementNode = parseStatement(0);
         if (statementNode != nullptr) {
-            children.push_back(AST_NODE(statementNode));
+            statements.push_back({AST_NODE(statementNode), firstTokenIdx, currentTokenIdx});
+            releaseTokensBefore(currentTokenIdx);
             continue;
         }
 
-        log.error("Unexpected token: " + to_string(token.type) + ": " + token.content);
-        error = true;
-        break;
+        token = tokenAt(currentTokenIdx);
+        if (token == nullptr) {
+            log.error("Unexpected token: parser backtracked out of the token window");
+        } else {
+            log.error("Unexpected token: " + to_string(token->type) + ": " + std::string(token->content));
+        }
+        return false;
+    }
+
+    LOG_DEBUG(log, "Maximum size of the token window: " + std::to_string(maxWindowSize));
+    LOG_DEBUG(log, "Number of backtracked tokens: " + std::to_string(backtrackedTokens));
+    return true;
+}
+
+void Parser::run(Module *module) {
+    tree = &module->ast;
+    if (mode == Mode::BUFFERED) {
+        while (!lexedAllTokens) {
+            getNextToken();
+        }
     }
 
-    if (error) {
+    std::vector<ParsedStatement> statements = {};
+    if (!parseTopLevelStatements(statements)) {
         return;
     }
 
-    auto *root = tree.root();
-    root->type = ast::NodeType::SEQUENCE;
-    for (auto *child : children) {
-        root->sequence.children.push_back(child);
+    std::vector<AstNode *> children = {};
+    children.reserve(statements.size());
+    for (const auto &statement : statements) {
+        children.push_back(statement.node);
+    }
+    tree->root()->sequence.children = tree->createSpan(children);
+    tree->completed();
+
+    if (mode == Mode::BUFFERED) {
+        module->tokens.assign(tokens.begin(), tokens.end());
+    }
+}
+
+bool Parser::parseStatements(Module *module, std::vector<Token> &allTokens, std::vector<ParsedStatement> &statements) {
+    tree = &module->ast;
+    // the token indices of the statements refer to allTokens, so no token may be released
+    mode = Mode::BUFFERED;
+    while (!lexedAllTokens) {
+        getNextToken();
+    }
+
+    if (!parseTopLevelStatements(statements)) {
+        return false;
     }
-    tree.completed();
 
-    module->ast = tree;
-    module->tokens = tokens;
+    allTokens.assign(tokens.begin(), tokens.end());
+    return true;
 }
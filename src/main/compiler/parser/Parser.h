@@ -1,26 +1,77 @@
 #pragma once
 
+#include <deque>
+
 #include "../../Module.h"
 #include "../Logger.h"
 #include "../ast/AstNode.h"
 
 class Parser {
+  public:
+    enum class Mode {
+        /// lex the whole module up front and keep the token stream on the module
+        BUFFERED,
+        /// pull tokens from the lexer while parsing and drop them once the statement that used them is complete
+        STREAMING,
+    };
+
+    /// a top level statement and the range of tokens it has been parsed from
+    struct ParsedStatement {
+        AstNode *node;
+        int firstToken;
+        int endToken;
+    };
+
+  private:
     const Logger &log;
     Lexer &lexer;
+    SymbolTable &symbols;
+    Mode mode;
 
-    AST tree;
-    std::vector<Token> tokens;
+    /// the AST of the module that is being parsed
+    AST *tree = nullptr;
+    /// tokens that are still reachable by backtracking, tokens.front() has the index windowStart
+    std::deque<Token> tokens;
+    int windowStart = 0;
     int currentTokenIdx = 0;
+    bool lexedAllTokens = false;
+    std::size_t maxWindowSize = 0;
+    std::size_t backtrackedTokens = 0;
 
   public:
-    Parser(const Logger &logger, Lexer &lexer) : log(logger), lexer(lexer) {}
+    Parser(const Logger &logger, Lexer &lexer, SymbolTable &symbols, Mode mode = Mode::BUFFERED)
+        : log(logger), lexer(lexer), symbols(symbols), mode(mode) {}
 
     void run(Module *module);
 
+    /**
+     * Parses the top level statements into the AST of the module without touching its root node.
+     * All tokens are kept, the token ranges of the statements are indices into allTokens.
+     * Used to re-parse parts of a module, returns false if there was a syntax error.
+     */
+    bool parseStatements(Module *module, std::vector<Token> &allTokens, std::vector<ParsedStatement> &statements);
+
+    /// largest number of tokens that had to be held in memory at the same time
+    [[nodiscard]] std::size_t getMaxWindowSize() const { return maxWindowSize; }
+    /// number of tokens that had to be looked at again, because a rule did not match after consuming them
+    [[nodiscard]] std::size_t getBacktrackedTokens() const { return backtrackedTokens; }
+
   private:
-    Token getNextToken();
-    [[nodiscard]] bool currentTokenIs(Token::TokenType tokenType) const;
-    [[nodiscard]] std::string currentTokenContent() const;
+    bool parseTopLevelStatements(std::vector<ParsedStatement> &statements);
+
+    void getNextToken();
+    /// returns nullptr if the token has already been released from the window or is past the end of the input
+    const Token *tokenAt(int idx);
+    /// marks all tokens before idx as unreachable, so that they can be released in streaming mode
+    void releaseTokensBefore(int idx);
+    /// resets the current token to idx
+    void backtrack(int idx);
+    [[nodiscard]] bool currentTokenIs(Token::TokenType tokenType);
+    [[nodiscard]] bool nextTokenIs(Token::TokenType tokenType);
+    [[nodiscard]] std::string currentTokenContent();
+    [[nodiscard]] SymbolId currentTokenSymbol();
+    /// interns the content of the current token, which has to be a string, without the surrounding quotes
+    [[nodiscard]] SymbolId currentTokenString();
 
     StatementNode *parseStatement(int level);
     AssertNode *parseAssert(int level);
@@ -28,7 +79,7 @@ class Parser {
     StatementNode *parseReturnStatement(int level);
     ForStatementNode *parseFor(int level);
     IfStatementNode *parseIf(int level);
-    AssignmentNode *parseAssignment(int level);
+    AstNode *parseAssignmentOrVariableDefinition(int level);
     FunctionNode *parseFunction(int level);
     SequenceNode *parseScope(int level);
     VariableDefinitionNode *parseVariableDefinition(int level);
@@ -39,13 +90,10 @@ class Parser {
     CommentNode *parseComment(int level);
     TypeDeclarationNode *parseTypeDeclaration(int level);
     TypeMemberNode *parseMemberVariable(int level);
-    MemberAccessNode *parseMemberAccess(int level);
+    AstNode *parseVariableOrMemberAccess(int level);
 
     AstNode *parseExpression(int level);
-    AstNode *parseEquality(int level);
-    AstNode *parseComparison(int level);
-    AstNode *parseTerm(int level);
-    AstNode *parseFactor(int level);
+    AstNode *parseBinaryOperation(int minPrecedence, int level);
     AstNode *parseUnary(int level);
     AstNode *parsePrimary(int level);
 
@@ -1,38 +1,37 @@
 #include "Parser.h"
 
 LiteralNode *Parser::parseLiteral(int level) {
-    log.debug(indent(level) + "parsing literal node");
+    LOG_DEBUG(log, indent(level) + "parsing literal node");
 
     if (currentTokenIs(Token::INTEGER)) {
-        log.debug(indent(level) + "parsing integer node");
+        LOG_DEBUG(log, indent(level) + "parsing integer node");
         int64_t value = std::stoi(currentTokenContent());
         currentTokenIdx++;
-        return tree.createLiteralInteger(value);
+        return tree->createLiteralInteger(value);
     }
 
     if (currentTokenIs(Token::FLOAT)) {
-        log.debug(indent(level) + "parsed float node");
+        LOG_DEBUG(log, indent(level) + "parsed float node");
         double value = std::stof(currentTokenContent());
         currentTokenIdx++;
-        return tree.createLiteralFloat(value);
+        return tree->createLiteralFloat(value);
     }
 
     if (currentTokenIs(Token::BOOLEAN)) {
-        log.debug(indent(level) + "parsed boolean node");
+        LOG_DEBUG(log, indent(level) + "parsed boolean node");
         bool value = currentTokenContent() == "true";
         currentTokenIdx++;
-        return tree.createLiteralBool(value);
+        return tree->createLiteralBool(value);
     }
 
     if (currentTokenIs(Token::STRING)) {
-        log.debug(indent(level) + "parsed string node");
-        std::string value = currentTokenContent();
-        value = value.substr(1, value.size() - 2);
+        LOG_DEBUG(log, indent(level) + "parsed string node");
+        auto value = currentTokenString();
         currentTokenIdx++;
-        return tree.createLiteralString(value);
+        return tree->createLiteralString(value);
     }
 
-    log.debug(indent(level) + "failed to parse literal node");
+    LOG_DEBUG(log, indent(level) + "failed to parse literal node");
     return nullptr;
 }
 
@@ -40,11 +39,11 @@ TypeMemberNode *Parser::parseMemberVariable(int level) {
     auto beforeTokenIdx = currentTokenIdx;
     auto *node = parseVariableDefinition(level + 1);
     if (node == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    return tree.createTypeMember(node);
+    return tree->createTypeMember(node);
 }
 
 TypeDeclarationNode *Parser::parseTypeDeclaration(int level) {
@@ -56,15 +55,15 @@ TypeDeclarationNode *Parser::parseTypeDeclaration(int level) {
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::IDENTIFIER)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
-    std::string name = currentTokenContent();
+    auto name = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_CURLY_BRACE)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
@@ -78,7 +77,7 @@ TypeDeclarationNode *Parser::parseTypeDeclaration(int level) {
 
         auto *memberVariable = parseMemberVariable(level + 1);
         if (memberVariable == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
+            backtrack(beforeTokenIdx);
             return nullptr;
         }
         memberVariables.push_back(memberVariable);
@@ -89,11 +88,11 @@ TypeDeclarationNode *Parser::parseTypeDeclaration(int level) {
     } while (!currentTokenIs(Token::RIGHT_CURLY_BRACE));
 
     if (!currentTokenIs(Token::RIGHT_CURLY_BRACE)) {
-        currentTokenIdx = beforeTokenIdx;
+        backtrack(beforeTokenIdx);
         return nullptr;
     }
 
     currentTokenIdx++;
 
-    return tree.createTypeDeclaration(name, memberVariables);
+    return tree->createTypeDeclaration(name, memberVariables);
 }
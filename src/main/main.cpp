@@ -1,25 +1,39 @@
 #include <iostream>
 
 #include "BuildEnv.h"
-#include "Linker.h"
-#include "compiler/Compiler.h"
-
-int main() {
-    //    auto program = new Program("examples/types.ne");
-    auto program = new Program("main.ne");
-    auto buildEnv = new BuildEnv();
+#include "CompileSession.h"
 
+int main(int argc, char **argv) {
     Logger logger = {};
     logger.setLogLevel(Logger::LogLevel::DEBUG_);
 
-    auto compiler = Compiler(program, buildEnv, logger);
-    if (compiler.run()) {
+    auto buildEnv = BuildEnv();
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument.rfind("-mcpu=", 0) == 0) {
+            buildEnv.targetCpu = argument.substr(std::string("-mcpu=").size());
+            continue;
+        }
+        if (argument.rfind("-mattr=", 0) == 0) {
+            buildEnv.targetFeatures = argument.substr(std::string("-mattr=").size());
+            continue;
+        }
+        const auto optimizationLevel = parseOptimizationLevel(argument);
+        if (!optimizationLevel.has_value()) {
+            std::cout << "Unknown option " << argument << std::endl;
+            return 1;
+        }
+        buildEnv.optimizationLevel = optimizationLevel.value();
+    }
+
+    auto session = CompileSession(buildEnv, logger);
+    //    if (session.compile("examples/types.ne")) {
+    if (session.compile("main.ne")) {
         std::cout << "Aborting after failed compilation..." << std::endl;
         return 1;
     }
 
-    auto linker = Linker(program, buildEnv, logger);
-    if (linker.link()) {
+    if (session.link()) {
         return 1;
     }
 
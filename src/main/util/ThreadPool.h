@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/// A fixed number of worker threads that execute submitted tasks in submission order.
+class ThreadPool {
+  public:
+    explicit ThreadPool(unsigned int numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    template <typename F> auto submit(F &&func) -> std::future<decltype(func())> {
+        using ResultType = decltype(func());
+        // std::function has to be copyable, std::packaged_task is not
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    [[nodiscard]] unsigned int size() const { return static_cast<unsigned int>(workers.size()); }
+
+  private:
+    std::vector<std::thread> workers = {};
+    std::queue<std::function<void()>> tasks = {};
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void work();
+};
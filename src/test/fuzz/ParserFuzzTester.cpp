@@ -7,10 +7,11 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     Logger logger = {};
     logger.setLogLevel(Logger::DISABLED);
     auto codeProvider = ByteCodeProvider((char *)data, size);
-    Lexer lexer(&codeProvider, logger);
+    auto symbols = SymbolTable();
+    Lexer lexer(&codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
     auto context = new llvm::LLVMContext();
     auto module = new Module("", *context);
-    Parser parser(logger, lexer);
+    Parser parser(logger, lexer, symbols);
     parser.run(module);
     return 0;
 }
@@ -3,9 +3,8 @@
 #include <string>
 
 #include <BuildEnv.h>
-#include <Linker.h>
+#include <CompileSession.h>
 #include <Program.h>
-#include <compiler/Compiler.h>
 #include <compiler/Logger.h>
 #include <util/Timing.h>
 
@@ -14,6 +13,21 @@ struct CmdArguments {
     std::string regex = {};
     bool verbose = false;
     bool noColor = false;
+    bool useRegexLexer = false;
+    bool bufferTokens = false;
+    bool useAstCache = false;
+    bool noFold = false;
+    bool noMem2Reg = false;
+    bool noStdLibBitcode = false;
+    /// parse incrementally and compile every test a second time after appending a function to it
+    bool incremental = false;
+    /// 0 keeps the default of BuildEnv
+    unsigned int numThreads = 0;
+    /// the whole suite is run once for each level
+    std::vector<OptimizationLevel> optimizationLevels = {};
+    /// empty keeps the default of BuildEnv
+    std::string targetCpu = {};
+    std::string targetFeatures = {};
 };
 
 struct TestResult {
@@ -56,15 +70,21 @@ int runTest(const BuildEnv *buildEnv, const Program *program, TimeKeeper &timeKe
     return std::system(executable.c_str());
 }
 
-TestResult compileAndRun(const std::string &path, const Logger &logger) {
+TestResult compileAndRun(const std::string &path, CompileSession &session) {
     auto timeKeeper = TimeKeeper();
-    auto program = new Program(path);
-    auto buildEnv = new BuildEnv();
 
     {
         auto timer = Timer(timeKeeper, "compile");
-        auto compiler = Compiler(program, buildEnv, logger);
-        if (compiler.run()) {
+        if (session.compile(path)) {
+            return {
+                  .exitCode = -1,
+            };
+        }
+
+        // the program that is run has been generated from the edited AST
+        const auto size = std::filesystem::file_size(path);
+        if (session.getBuildEnv().incrementalParsing &&
+            session.recompile(path, size, size, "\nfun appendedByTheTester() int {\n    return 42\n}\n")) {
             return {
                   .exitCode = -1,
             };
@@ -73,15 +93,16 @@ TestResult compileAndRun(const std::string &path, const Logger &logger) {
 
     {
         auto timer = Timer(timeKeeper, "link");
-        auto linker = Linker(program, buildEnv, logger);
-        if (linker.link()) {
+        if (session.link()) {
             return {
                   .exitCode = -1,
             };
         }
     }
 
-    int exitCode = runTest(buildEnv, program, timeKeeper);
+    int exitCode = runTest(&session.getBuildEnv(), session.getProgram(), timeKeeper);
+    // the memory of the test program is not needed anymore, the session is reused for the next test
+    session.reset();
 
 #ifdef WIN32
     return {
@@ -159,6 +180,45 @@ CmdArguments parseArgs(int argc, char **argv) {
         } else if (argument == "--plain") {
             result.noColor = true;
             continue;
+        } else if (argument == "--regex-lexer") {
+            result.useRegexLexer = true;
+            continue;
+        } else if (argument == "--buffer-tokens") {
+            result.bufferTokens = true;
+            continue;
+        } else if (argument == "--ast-cache") {
+            result.useAstCache = true;
+            continue;
+        } else if (argument == "--no-fold") {
+            result.noFold = true;
+            continue;
+        } else if (argument == "--no-mem2reg") {
+            result.noMem2Reg = true;
+            continue;
+        } else if (argument == "--no-std-bitcode") {
+            result.noStdLibBitcode = true;
+            continue;
+        } else if (argument == "--incremental") {
+            result.incremental = true;
+            continue;
+        } else if (argument.rfind("-mcpu=", 0) == 0) {
+            result.targetCpu = argument.substr(std::string("-mcpu=").size());
+            continue;
+        } else if (argument.rfind("-mattr=", 0) == 0) {
+            result.targetFeatures = argument.substr(std::string("-mattr=").size());
+            continue;
+        } else if (const auto optimizationLevel = parseOptimizationLevel(argument); optimizationLevel.has_value()) {
+            result.optimizationLevels.push_back(optimizationLevel.value());
+            continue;
+        } else if (argument == "-j" || argument == "--threads") {
+            if (i + 1 < argc) {
+                result.numThreads = std::stoul(argv[i + 1]);
+                i++;
+                continue;
+            } else {
+                std::cout << "expected number of threads, but there were no more arguments" << std::endl;
+                continue;
+            }
         } else if (argument == "-r" || argument == "--regex") {
             if (i + 1 < argc) {
                 result.regex = std::string(argv[i + 1]);
@@ -197,6 +257,24 @@ int main(int argc, char **argv) {
     }
     logger.setColorEnabled(!args.noColor);
 
+    auto buildEnv = BuildEnv();
+    buildEnv.useRegexLexer = args.useRegexLexer;
+    buildEnv.streamTokens = !args.bufferTokens;
+    buildEnv.useAstCache = args.useAstCache;
+    buildEnv.foldConstants = !args.noFold;
+    buildEnv.promoteAllocas = !args.noMem2Reg;
+    buildEnv.linkStdLibBitcode = !args.noStdLibBitcode;
+    buildEnv.incrementalParsing = args.incremental;
+    if (args.numThreads > 0) {
+        buildEnv.numThreads = args.numThreads;
+    }
+    if (!args.targetCpu.empty()) {
+        buildEnv.targetCpu = args.targetCpu;
+    }
+    buildEnv.targetFeatures = args.targetFeatures;
+    // all tests are compiled in the same session, like they would be in a long running compiler process
+    auto session = CompileSession(buildEnv, logger);
+
     std::cout << std::fixed;
     std::cout << std::setprecision(2);
     bool success = true;
@@ -207,26 +285,37 @@ int main(int argc, char **argv) {
     double runTimeTotalMillis = 0;
     double linkTimeTotalMillis = 0;
 
+    std::vector<OptimizationLevel> optimizationLevels = args.optimizationLevels;
+    if (optimizationLevels.empty()) {
+        optimizationLevels.push_back(buildEnv.optimizationLevel);
+    }
+
     std::vector<std::filesystem::path> tests = collectTests(args);
-    for (const auto &path : tests) {
-        totalNumTests++;
-
-        const TestResult &result = compileAndRun(path.string(), logger);
-        if (!result.success()) {
-            std::cout << addResultColor(false, false) << "FAILURE";
-            success = false;
-        } else {
-            std::cout << addResultColor(true, false) << "SUCCESS";
-            successfulTests++;
+    for (const auto optimizationLevel : optimizationLevels) {
+        session.getBuildEnv().optimizationLevel = optimizationLevel;
+        for (const auto &path : tests) {
+            totalNumTests++;
+
+            const TestResult &result = compileAndRun(path.string(), session);
+            if (optimizationLevels.size() > 1) {
+                std::cout << to_string(optimizationLevel) << " ";
+            }
+            if (!result.success()) {
+                std::cout << addResultColor(false, false) << "FAILURE";
+                success = false;
+            } else {
+                std::cout << addResultColor(true, false) << "SUCCESS";
+                successfulTests++;
+            }
+            std::cout << "\u001b[0m";
+
+            compileTimeTotalMillis += result.compileTimeMillis();
+            linkTimeTotalMillis += result.linkTimeMillis();
+            runTimeTotalMillis += result.runTimeMillis();
+            std::cout << " (compile: " << std::setw(7) << result.compileTimeMillis() << "ms, link: " << std::setw(7)
+                      << result.linkTimeMillis() << "ms, run: " << std::setw(7) << result.runTimeMillis()
+                      << "ms, exitCode: " << std::setw(2) << result.exitCode << "): " << path << std::endl;
         }
-        std::cout << "\u001b[0m";
-
-        compileTimeTotalMillis += result.compileTimeMillis();
-        linkTimeTotalMillis += result.linkTimeMillis();
-        runTimeTotalMillis += result.runTimeMillis();
-        std::cout << " (compile: " << std::setw(7) << result.compileTimeMillis() << "ms, link: " << std::setw(7)
-                  << result.linkTimeMillis() << "ms, run: " << std::setw(7) << result.runTimeMillis()
-                  << "ms, exitCode: " << std::setw(2) << result.exitCode << "): " << path << std::endl;
     }
 
     int exitCode = 0;
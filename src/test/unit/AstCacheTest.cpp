@@ -0,0 +1,154 @@
+#include <catch2/catch.hpp>
+
+#include "parser/ParserTestHelper.h"
+
+#include "compiler/AstCache.h"
+#include "compiler/ast/visitors/ComplexTypeFinder.h"
+#include "compiler/ast/visitors/FunctionFinder.h"
+#include "compiler/ast/visitors/ImportFinder.h"
+#include "compiler/parser/Parser.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+std::string readCode(Module &module) {
+    return std::string(module.getCodeProvider()->getRemainingCode().value_or(std::string_view()));
+}
+
+ModuleCompileState parseModule(Module &module, const std::string &code, SymbolTable &symbols) {
+    Logger logger = {};
+    auto codeProvider = BufferCodeProvider(code);
+    auto lexer = Lexer(&codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
+    Parser(logger, lexer, symbols).run(&module);
+    REQUIRE(module.ast.is_complete());
+
+    ModuleCompileState state = {};
+    state.imports = ImportFinder(symbols, module.getDirectoryPath()).run(module.ast);
+    state.functions = FunctionFinder(symbols).run(module.ast);
+    state.complexTypes = ComplexTypeFinder(symbols).run(module.ast);
+    return state;
+}
+
+std::vector<std::string> functionNames(const ModuleCompileState &state, const SymbolTable &symbols) {
+    std::vector<std::string> result = {};
+    for (const auto &function : state.functions) {
+        std::string name = symbols.name(function.name) + "(";
+        for (const auto &argument : function.arguments) {
+            name += symbols.name(argument.name) + ": " + argument.type.name() + ", ";
+        }
+        result.push_back(name + ") " + function.returnType.name());
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("AstCache") {
+    Logger logger = {};
+    // corrupt entries are reported as warnings
+    logger.setLogLevel(Logger::LogLevel::ERROR);
+    llvm::LLVMContext context = {};
+    const auto cacheDirectory = std::filesystem::temp_directory_path() / "neon_ast_cache_test";
+    std::filesystem::remove_all(cacheDirectory);
+
+    SECTION("restores the AST and the declarations of all test programs") {
+        for (const auto &entry : std::filesystem::directory_iterator(NEON_TEST_PROGRAMS_DIRECTORY)) {
+            if (entry.path().extension() != ".ne") {
+                continue;
+            }
+            INFO(entry.path().string());
+
+            auto writerSymbols = SymbolTable();
+            auto parsedModule = Module(entry.path(), context);
+            const auto code = readCode(parsedModule);
+            const auto parsedState = parseModule(parsedModule, code, writerSymbols);
+            AstCache(logger, writerSymbols, cacheDirectory).store(&parsedModule, code, parsedState);
+
+            // the ids of the names are different in another program
+            auto readerSymbols = SymbolTable();
+            readerSymbols.intern("some other name");
+            auto cachedModule = Module(entry.path(), context);
+            ModuleCompileState cachedState = {};
+            REQUIRE(AstCache(logger, readerSymbols, cacheDirectory).load(&cachedModule, code, cachedState));
+
+            REQUIRE(cachedModule.ast.is_complete());
+            REQUIRE(astsAreEqual(createSimpleFromAst(parsedModule.ast.root()),
+                                 createSimpleFromAst(cachedModule.ast.root()), 0));
+            REQUIRE(cachedState.imports == parsedState.imports);
+            REQUIRE(functionNames(cachedState, readerSymbols) == functionNames(parsedState, writerSymbols));
+            REQUIRE(cachedState.complexTypes.size() == parsedState.complexTypes.size());
+        }
+    }
+
+    SECTION("keeps the contents of literals") {
+        const std::string code = "string s = \"hello\"\nfloat f = 1.5\nint i = 7\nbool b = true\n";
+        auto symbols = SymbolTable();
+        auto parsedModule = Module("literals.ne", context);
+        AstCache(logger, symbols, cacheDirectory).store(&parsedModule, code, parseModule(parsedModule, code, symbols));
+
+        auto cachedModule = Module("literals.ne", context);
+        ModuleCompileState state = {};
+        REQUIRE(AstCache(logger, symbols, cacheDirectory).load(&cachedModule, code, state));
+
+        const auto &statements = cachedModule.ast.root()->sequence.children;
+        REQUIRE(statements.size() == 4);
+        auto literalOf = [](AstNode *statement) { return &statement->statement.child->assignment.right->literal; };
+        REQUIRE(symbols.name(literalOf(statements[0])->s) == "hello");
+        REQUIRE(literalOf(statements[1])->d == 1.5);
+        REQUIRE(literalOf(statements[2])->i == 7);
+        REQUIRE(literalOf(statements[3])->b);
+    }
+
+    SECTION("does not use the entry of different code") {
+        const std::string code = "int a = 1\n";
+        auto symbols = SymbolTable();
+        auto parsedModule = Module("a.ne", context);
+        auto cache = AstCache(logger, symbols, cacheDirectory);
+        cache.store(&parsedModule, code, parseModule(parsedModule, code, symbols));
+
+        auto cachedModule = Module("a.ne", context);
+        ModuleCompileState state = {};
+        REQUIRE_FALSE(cache.load(&cachedModule, "int a = 2\n", state));
+        REQUIRE_FALSE(cachedModule.ast.is_complete());
+
+        // a corrupt entry is ignored as well
+        std::filesystem::resize_file(cache.entryPath(code), 40);
+        REQUIRE_FALSE(cache.load(&cachedModule, code, state));
+    }
+
+    SECTION("rejects entries with invalid operations or missing children") {
+        const std::string code = "int a = 1 + 2\n";
+        auto symbols = SymbolTable();
+        auto parsedModule = Module("b.ne", context);
+        auto cache = AstCache(logger, symbols, cacheDirectory);
+        cache.store(&parsedModule, code, parseModule(parsedModule, code, symbols));
+
+        std::string entry = {};
+        {
+            std::ifstream file(cache.entryPath(code), std::ios::binary);
+            entry.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        // children are written first, the addition comes after the variable definition (0) and the literals (1, 2)
+        const std::string addition = {static_cast<char>(ast::NodeType::BINARY_OPERATION),
+                                      static_cast<char>(ast::BinaryOperationType::ADDITION), 1, 0, 0, 0, 2, 0, 0, 0};
+        const auto position = entry.find(addition);
+        REQUIRE(position != std::string::npos);
+
+        auto loadModified = [&](std::size_t offset, const std::string &bytes) {
+            auto modified = entry;
+            modified.replace(position + offset, bytes.size(), bytes);
+            std::ofstream(cache.entryPath(code), std::ios::binary) << modified;
+            auto cachedModule = Module("b.ne", context);
+            ModuleCompileState state = {};
+            return cache.load(&cachedModule, code, state);
+        };
+        REQUIRE(loadModified(0, {}));
+        REQUIRE_FALSE(loadModified(1, {static_cast<char>(static_cast<uint8_t>(ast::BinaryOperationType::OR) + 1)}));
+        const std::string noNode(4, static_cast<char>(0xFF));
+        REQUIRE_FALSE(loadModified(6, noNode));
+    }
+
+    std::filesystem::remove_all(cacheDirectory);
+}
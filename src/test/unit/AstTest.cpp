@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ast/AST.h"
+#include "compiler/ast/AstNodeTable.h"
+#include "compiler/ast/visitors/AstVisitor.h"
+
+namespace {
+
+class LiteralCounter : public AstVisitor<LiteralCounter> {
+  public:
+    int numLiterals = 0;
+    void visitLiteralNode(LiteralNode * /*node*/) { numLiterals++; }
+};
+
+class CallCounter : public AstVisitor<CallCounter> {
+  public:
+    int numCalls = 0;
+    void visitCallNode(CallNode * /*node*/) { numCalls++; }
+};
+
+} // namespace
+
+TEST_CASE("AST") {
+    SECTION("starts with an empty root sequence") {
+        AST tree = {};
+        REQUIRE(tree.size() == 1);
+        REQUIRE(tree.root()->type == ast::NodeType::SEQUENCE);
+        REQUIRE(tree.root()->id == 0);
+        REQUIRE(tree.root()->sequence.children.empty());
+    }
+
+    SECTION("nodes stay where they are while the tree grows") {
+        AST tree = {};
+        const int numNodes = 200000;
+        std::vector<LiteralNode *> literals = {};
+        std::vector<AstNode *> children = {};
+        for (int i = 0; i < numNodes; i++) {
+            literals.push_back(tree.createLiteralInteger(i));
+            children.push_back(AST_NODE(tree.createLiteralString(static_cast<SymbolId>(i))));
+        }
+        tree.root()->sequence.children = tree.createSpan(children);
+
+        REQUIRE(tree.size() == 2 * numNodes + 1);
+        REQUIRE(tree.root()->sequence.children.size() == numNodes);
+        int numValidNodes = 0;
+        for (int i = 0; i < numNodes; i++) {
+            if (literals[i]->i == i && tree.root()->sequence.children[i]->literal.s == static_cast<SymbolId>(i)) {
+                numValidNodes++;
+            }
+        }
+        REQUIRE(numValidNodes == numNodes);
+    }
+
+    SECTION("node ids are dense") {
+        AST tree = {};
+        auto *left = AST_NODE(tree.createLiteralInteger(1));
+        auto *right = AST_NODE(tree.createLiteralInteger(2));
+        auto *operation = AST_NODE(tree.createBinaryOperation(ast::BinaryOperationType::ADDITION, left, right));
+        REQUIRE(left->id == 1);
+        REQUIRE(right->id == 2);
+        REQUIRE(operation->id == 3);
+        REQUIRE(operation->binary_operation.left == left);
+    }
+
+    SECTION("child lists keep their contents while more of them are created") {
+        AST tree = {};
+        const int numSequences = 1000;
+        std::vector<SequenceNode *> sequences = {};
+        for (int i = 0; i < numSequences; i++) {
+            std::vector<AstNode *> children = {};
+            for (int j = 0; j <= i % 100; j++) {
+                children.push_back(AST_NODE(tree.createLiteralInteger(i)));
+            }
+            sequences.push_back(tree.createSequence(children));
+        }
+
+        int numValidSequences = 0;
+        for (int i = 0; i < numSequences; i++) {
+            const auto &children = sequences[i]->children;
+            bool valid = children.size() == static_cast<std::size_t>(i % 100 + 1);
+            for (auto *child : children) {
+                valid = valid && child->literal.i == i;
+            }
+            if (valid) {
+                numValidSequences++;
+            }
+        }
+        REQUIRE(numValidSequences == numSequences);
+    }
+}
+
+TEST_CASE("AstVisitor") {
+    AST tree = {};
+    auto *call = AST_NODE(tree.createCall(NO_SYMBOL, {AST_NODE(tree.createLiteralInteger(1))}));
+    std::vector<AstNode *> statements = {
+          AST_NODE(tree.createStatement(AST_NODE(tree.createLiteralInteger(2)), false)),
+          AST_NODE(tree.createStatement(call, false)),
+          AST_NODE(tree.createLiteralBool(true)),
+    };
+    tree.root()->sequence.children = tree.createSpan(statements);
+
+    SECTION("only dispatches to the visit methods a pass defines") {
+        auto literalCounter = LiteralCounter();
+        literalCounter.visitNode(call);
+        literalCounter.visitNode(call->call.arguments[0]);
+        REQUIRE(literalCounter.numLiterals == 1);
+    }
+
+    SECTION("hands every declaration to all passes in one walk") {
+        auto literalCounter = LiteralCounter();
+        auto callCounter = CallCounter();
+        visitDeclarations(tree.root(), literalCounter, callCounter);
+        // the argument of the call is not a declaration
+        REQUIRE(literalCounter.numLiterals == 2);
+        REQUIRE(callCounter.numCalls == 1);
+    }
+}
+
+TEST_CASE("AstNodeTable") {
+    AST tree = {};
+    auto *first = AST_NODE(tree.createLiteralInteger(1));
+    auto *second = AST_NODE(tree.createLiteralInteger(2));
+
+    auto table = AstNodeTable<ast::DataType>(tree.size());
+    auto *third = AST_NODE(tree.createLiteralInteger(3));
+    table[first] = ast::DataType(ast::SimpleDataType::INTEGER);
+    REQUIRE(table.get(first) == ast::DataType(ast::SimpleDataType::INTEGER));
+    // nodes without a value (even ones that have been created after the table) map to the default value
+    REQUIRE(table.get(second) == ast::DataType(ast::SimpleDataType::VOID));
+    REQUIRE(table.get(third) == ast::DataType(ast::SimpleDataType::VOID));
+    table[second] = table[first];
+    REQUIRE(table.get(second) == ast::DataType(ast::SimpleDataType::INTEGER));
+    table[second] = ast::DataType(ast::SimpleDataType::STRING);
+    REQUIRE(table.get(second) == ast::DataType(ast::SimpleDataType::STRING));
+    REQUIRE(table.get(first) == ast::DataType(ast::SimpleDataType::INTEGER));
+}
+
+TEST_CASE("DataType") {
+    REQUIRE(ast::DataType() == ast::DataType(ast::SimpleDataType::VOID));
+    REQUIRE(ast::DataType("INT") == ast::DataType(ast::SimpleDataType::INTEGER));
+    REQUIRE(ast::DataType(ast::SimpleDataType::FLOAT).name() == "FLOAT");
+    REQUIRE(ast::isSimpleDataType(ast::DataType(ast::SimpleDataType::STRING)));
+
+    const auto point = ast::DataType("Point");
+    REQUIRE(point == ast::DataType(std::string("Point")));
+    REQUIRE(point != ast::DataType("Line"));
+    REQUIRE(point.name() == "Point");
+    REQUIRE_FALSE(ast::isSimpleDataType(point));
+    REQUIRE(ast::toSimpleDataType(point) == ast::SimpleDataType::VOID);
+}
@@ -0,0 +1,29 @@
+#include <catch2/catch.hpp>
+
+#include "CompileSession.h"
+#include "CompilerTestHelper.h"
+
+TEST_CASE("CompileSession") {
+    Logger logger = {};
+    const auto buildDirectory = TestBuildDirectory("neon_compile_session_test");
+    auto session = CompileSession(BuildEnv(buildDirectory.path().string()), logger);
+
+    // with several threads, the modules are generated in their own LLVMContexts and merged through bitcode
+    for (const unsigned int numThreads : {1U, 4U}) {
+        INFO("threads: " << numThreads);
+        session.getBuildEnv().numThreads = numThreads;
+        REQUIRE_FALSE(session.compile("tests/import_test.ne"));
+        REQUIRE(session.getProgram() != nullptr);
+        REQUIRE(session.getProgram()->modules.size() > 1);
+        for (const auto &entry : session.getProgram()->modules) {
+            // the ASTs and tokens are released once they are not needed anymore
+            REQUIRE(entry.second->ast.size() == 1);
+            REQUIRE(entry.second->tokens.empty());
+        }
+    }
+
+    session.reset();
+    REQUIRE(session.getProgram() == nullptr);
+    // the type names of the program have been released as well
+    REQUIRE(ast::DataType("NotAType").id == ast::SimpleDataType::STRING + 1);
+}
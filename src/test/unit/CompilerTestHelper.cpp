@@ -0,0 +1,16 @@
+#include "CompilerTestHelper.h"
+
+TestBuildDirectory::TestBuildDirectory(const std::string &name)
+    : workingDirectory(std::filesystem::current_path()),
+      buildDirectory(std::filesystem::temp_directory_path() / name) {
+    // modules are compiled into the build directory relative to the working directory
+    std::filesystem::current_path(std::filesystem::path(NEON_TEST_PROGRAMS_DIRECTORY).parent_path());
+    std::filesystem::remove_all(buildDirectory);
+}
+
+TestBuildDirectory::~TestBuildDirectory() {
+    // the destructor might run while an exception of a failed REQUIRE is on its way, so it must not throw
+    std::error_code error = {};
+    std::filesystem::current_path(workingDirectory, error);
+    std::filesystem::remove_all(buildDirectory, error);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/**
+ * Sets up the environment that test programs are compiled in, just like the NeonTester does: the working directory is
+ * the parent of the tests directory and the build directory is a temporary directory. Both are undone when the guard
+ * goes out of scope, even if the test failed.
+ */
+class TestBuildDirectory {
+  public:
+    explicit TestBuildDirectory(const std::string &name);
+    ~TestBuildDirectory();
+
+    TestBuildDirectory(const TestBuildDirectory &) = delete;
+    TestBuildDirectory &operator=(const TestBuildDirectory &) = delete;
+
+    [[nodiscard]] const std::filesystem::path &path() const { return buildDirectory; }
+
+  private:
+    std::filesystem::path workingDirectory;
+    std::filesystem::path buildDirectory;
+};
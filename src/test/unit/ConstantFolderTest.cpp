@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include "CompilerTestHelper.h"
+#include "compiler/Compiler.h"
+#include "compiler/ast/visitors/ConstantFolder.h"
+#include "compiler/parser/Parser.h"
+
+#include <algorithm>
+
+namespace {
+
+/// parses code, folds it and returns the right side of the assignment in the first statement
+AstNode *foldAssignment(Module &module, SymbolTable &symbols, const std::string &code) {
+    Logger logger = {};
+    auto codeProvider = BufferCodeProvider(code);
+    auto lexer = Lexer(&codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
+    Parser(logger, lexer, symbols).run(&module);
+    REQUIRE(module.ast.is_complete());
+
+    ConstantFolder(symbols).run(module.ast);
+    return module.ast.root()->sequence.children[0]->statement.child->assignment.right;
+}
+
+} // namespace
+
+TEST_CASE("ConstantFolder") {
+    llvm::LLVMContext context = {};
+    auto module = Module("folding.ne", context);
+    auto symbols = SymbolTable();
+
+    SECTION("folds integer arithmetic") {
+        auto *node = foldAssignment(module, symbols, "int seconds = 2 * 60 * 60 - -10\n");
+        REQUIRE(node->type == ast::NodeType::LITERAL);
+        REQUIRE(node->literal.type == LiteralType::INTEGER);
+        REQUIRE(node->literal.i == 7210);
+    }
+
+    SECTION("folds float arithmetic") {
+        auto *node = foldAssignment(module, symbols, "float f = 1.5 * 2.0 + 0.25\n");
+        REQUIRE(node->type == ast::NodeType::LITERAL);
+        REQUIRE(node->literal.d == 3.25);
+    }
+
+    SECTION("concatenates strings") {
+        auto *node = foldAssignment(module, symbols, "string s = \"abc\" + \"def\"\n");
+        REQUIRE(node->type == ast::NodeType::LITERAL);
+        REQUIRE(symbols.name(node->literal.s) == "abcdef");
+    }
+
+    SECTION("folds comparisons and booleans") {
+        auto *node = foldAssignment(module, symbols, "bool b = not (3 < 2) and (1.0 == 1.0 or false)\n");
+        REQUIRE(node->type == ast::NodeType::LITERAL);
+        REQUIRE(node->literal.type == LiteralType::BOOL);
+        REQUIRE(node->literal.b);
+    }
+
+    SECTION("leaves divisions by zero alone") {
+        auto *node = foldAssignment(module, symbols, "int i = (1 + 1) / 0\n");
+        REQUIRE(node->type == ast::NodeType::BINARY_OPERATION);
+        REQUIRE(node->binary_operation.left->type == ast::NodeType::LITERAL);
+        REQUIRE(node->binary_operation.left->literal.i == 2);
+    }
+
+    SECTION("leaves operations on variables alone") {
+        auto *node = foldAssignment(module, symbols, "int i = i + 1\n");
+        REQUIRE(node->type == ast::NodeType::BINARY_OPERATION);
+    }
+
+    SECTION("removes branches that are never taken") {
+        Logger logger = {};
+        auto codeProvider = BufferCodeProvider("if 1 > 2 {\n int a = 1\n} else {\n int b = 2\n}\n");
+        auto lexer = Lexer(&codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
+        Parser(logger, lexer, symbols).run(&module);
+        REQUIRE(module.ast.is_complete());
+
+        auto folder = ConstantFolder(symbols);
+        folder.run(module.ast);
+        auto &ifStatement = module.ast.root()->sequence.children[0]->statement.child->if_statement;
+        REQUIRE(ifStatement.condition->type == ast::NodeType::LITERAL);
+        REQUIRE(ifStatement.ifBody == nullptr);
+        REQUIRE(ifStatement.elseBody != nullptr);
+        REQUIRE(folder.getNumRemovedBranches() == 1);
+    }
+}
+
+TEST_CASE("IrGenerator only drops the branches of literal conditions when folding") {
+    Logger logger = {};
+    const auto buildDirectory = TestBuildDirectory("neon_constant_folder_test");
+    auto buildEnv = BuildEnv(buildDirectory.path().string());
+    buildEnv.numThreads = 1;
+
+    for (const bool foldConstants : {true, false}) {
+        INFO("foldConstants: " << foldConstants);
+        buildEnv.foldConstants = foldConstants;
+        const std::string fileName = "tests/if_statements_test.ne";
+        auto program = Program(fileName);
+        REQUIRE_FALSE(Compiler(&program, &buildEnv, logger).run());
+
+        const auto &blocks = program.modules.at(fileName)->llvmModule.getFunction("main")->getBasicBlockList();
+        const bool hasBranches = std::any_of(blocks.begin(), blocks.end(), [](const llvm::BasicBlock &block) {
+            return block.getName().startswith("then");
+        });
+        REQUIRE(hasBranches == !foldConstants);
+    }
+}
@@ -1,16 +1,21 @@
 #include <catch2/catch.hpp>
 
 #include "compiler/lexer/Lexer.h"
+#include "util/ThreadPool.h"
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <unordered_map>
 
-Lexer getLexer(const std::vector<std::string> &lines, Logger &logger) {
+Lexer getLexer(const std::vector<std::string> &lines, Logger &logger, Lexer::Mode mode = Lexer::Mode::TABLE_DRIVEN) {
     CodeProvider *codeProvider = new StringCodeProvider(lines, false);
-    auto lexer = Lexer(codeProvider, logger);
+    auto lexer = Lexer(codeProvider, logger, mode);
     return lexer;
 }
 
-bool tokensCanBeLexed(const std::vector<std::pair<std::string, Token::TokenType>> &tokens) {
+bool tokensCanBeLexed(const std::vector<std::pair<std::string, Token::TokenType>> &tokens,
+                      Lexer::Mode mode = Lexer::Mode::TABLE_DRIVEN) {
     std::vector<std::string> lines;
     lines.reserve(tokens.size());
     for (auto &kv : tokens) {
@@ -18,14 +23,14 @@ bool tokensCanBeLexed(const std::vector<std::pair<std::string, Token::TokenType>
     }
 
     Logger logger = {};
-    auto lexer = getLexer(lines, logger);
+    auto lexer = getLexer(lines, logger, mode);
     for (auto &expectedToken : tokens) {
         auto actualToken = lexer.getToken();
         UNSCOPED_INFO(to_string(actualToken.type) + " != " + to_string(expectedToken.second));
         if (actualToken.type != expectedToken.second) {
             return false;
         }
-        UNSCOPED_INFO(actualToken.content + " != " + expectedToken.first);
+        UNSCOPED_INFO(std::string(actualToken.content) + " != " + expectedToken.first);
         if (actualToken.content != expectedToken.first) {
             return false;
         }
@@ -127,6 +132,134 @@ TEST_CASE("Lexer") {
               {"assert", Token::ASSERT},
         };
         REQUIRE(tokensCanBeLexed(tokens));
+        REQUIRE(tokensCanBeLexed(tokens, Lexer::Mode::REGEX));
+    }
+
+    SECTION("can handle identifiers that start with a keyword") {
+        std::vector<std::pair<std::string, Token::TokenType>> tokens = {
+              {"format", Token::IDENTIFIER},
+              {"iffy", Token::IDENTIFIER},
+              {"integer", Token::IDENTIFIER},
+              {"truely", Token::IDENTIFIER},
+              {"types", Token::IDENTIFIER},
+              {"or_else", Token::IDENTIFIER},
+        };
+        REQUIRE(tokensCanBeLexed(tokens));
+    }
+
+    SECTION("can handle comments") {
+        std::vector<std::string> lines = {"# a comment\n", "1"};
+        Logger logger = {};
+        auto lexer = getLexer(lines, logger);
+        auto token = lexer.getToken();
+        REQUIRE(token.type == Token::COMMENT);
+        REQUIRE(token.content == "# a comment\n");
+
+        token = lexer.getToken();
+        REQUIRE(token.type == Token::INTEGER);
+        REQUIRE(token.content == "1");
+    }
+
+    SECTION("can handle invalid tokens") {
+        std::vector<std::string> lines = {"1 ! 2"};
+        Logger logger = {};
+        auto lexer = getLexer(lines, logger);
+        REQUIRE(lexer.getToken().type == Token::INTEGER);
+
+        auto token = lexer.getToken();
+        REQUIRE(token.type == Token::INVALID);
+        REQUIRE(token.content == "!");
+    }
+
+    SECTION("produces the same tokens as the regex lexer for all test programs") {
+        for (const auto &entry : std::filesystem::directory_iterator(NEON_TEST_PROGRAMS_DIRECTORY)) {
+            if (entry.path().extension() != ".ne") {
+                continue;
+            }
+
+            Logger logger = {};
+            auto tableProvider = FileCodeProvider(entry.path());
+            auto regexProvider = FileCodeProvider(entry.path());
+            auto tableLexer = Lexer(&tableProvider, logger, Lexer::Mode::TABLE_DRIVEN);
+            auto regexLexer = Lexer(&regexProvider, logger, Lexer::Mode::REGEX);
+            while (true) {
+                auto expected = regexLexer.getToken();
+                auto actual = tableLexer.getToken();
+                INFO(entry.path().string() + ": " + std::string(expected.content) + " | " + std::string(actual.content));
+                REQUIRE(actual.type == expected.type);
+                REQUIRE(actual.content == expected.content);
+                if (expected.type == Token::INVALID) {
+                    break;
+                }
+            }
+        }
+    }
+
+    SECTION("parallel lexing produces the same tokens as sequential lexing") {
+        auto path = std::filesystem::temp_directory_path() / "neon_parallel_lexer_test.ne";
+        {
+            std::ofstream file(path);
+            for (const auto &entry : std::filesystem::directory_iterator(NEON_TEST_PROGRAMS_DIRECTORY)) {
+                if (entry.path().extension() != ".ne") {
+                    continue;
+                }
+                std::ifstream program(entry.path());
+                file << program.rdbuf() << "\n";
+            }
+            file << "# comment with \"quotes\" and ! in it\nstring s = \"# not a comment\" ! invalid";
+        }
+
+        auto threadPool = ThreadPool(4);
+        for (std::size_t chunkSize : {1, 64, 1024, 1024 * 1024}) {
+            // the chunks are lexed on other threads, their messages have to end up in the output of the lexer
+            auto sequentialOutput = std::ostringstream();
+            auto parallelOutput = std::ostringstream();
+            Logger sequentialLogger = {};
+            Logger parallelLogger = {};
+            for (auto *logger : {&sequentialLogger, &parallelLogger}) {
+                logger->setLogLevel(Logger::DEBUG_);
+                logger->setColorEnabled(false);
+            }
+            sequentialLogger.setOutput(&sequentialOutput);
+            parallelLogger.setOutput(&parallelOutput);
+            auto sequentialSymbols = SymbolTable();
+            auto parallelSymbols = SymbolTable();
+            auto sequentialProvider = FileCodeProvider(path);
+            auto parallelProvider = FileCodeProvider(path);
+            auto sequentialLexer =
+                  Lexer(&sequentialProvider, sequentialLogger, Lexer::Mode::TABLE_DRIVEN, &sequentialSymbols);
+            auto parallelLexer = Lexer(&parallelProvider, parallelLogger, Lexer::Mode::TABLE_DRIVEN, &parallelSymbols);
+            parallelLexer.lexInParallel(threadPool, chunkSize);
+
+            int numTokens = 0;
+            while (true) {
+                auto expected = sequentialLexer.getToken();
+                auto actual = parallelLexer.getToken();
+                INFO(std::to_string(chunkSize) + ", token " + std::to_string(numTokens) + ": " +
+                     std::string(expected.content) + " | " + std::string(actual.content));
+                REQUIRE(actual.type == expected.type);
+                REQUIRE(actual.content == expected.content);
+                REQUIRE(actual.symbol == expected.symbol);
+                if (expected.type == Token::INVALID && expected.content.empty()) {
+                    break;
+                }
+                numTokens++;
+            }
+            REQUIRE(numTokens > 500);
+
+            const auto countInvalidTokens = [](const std::string &output) {
+                std::size_t result = 0;
+                for (auto pos = output.find("Found an invalid token"); pos != std::string::npos;
+                     pos = output.find("Found an invalid token", pos + 1)) {
+                    result++;
+                }
+                return result;
+            };
+            REQUIRE(countInvalidTokens(sequentialOutput.str()) > 0);
+            REQUIRE(countInvalidTokens(parallelOutput.str()) == countInvalidTokens(sequentialOutput.str()));
+        }
+
+        std::filesystem::remove(path);
     }
 
     SECTION("can handle variable names") {
@@ -147,3 +280,29 @@ TEST_CASE("Lexer") {
         REQUIRE(tokensCanBeLexed(tokens));
     }
 }
+
+TEST_CASE("CodeProvider") {
+    SECTION("file code provider returns one line after the other") {
+        auto path = std::filesystem::temp_directory_path() / "neon_file_code_provider_test.ne";
+        {
+            std::ofstream file(path);
+            file << "int a = 0\n\nassert a == 0";
+        }
+
+        auto codeProvider = FileCodeProvider(path);
+        REQUIRE(codeProvider.getMoreCode().value() == "int a = 0\n");
+        REQUIRE(codeProvider.getMoreCode().value() == "\n");
+        REQUIRE(codeProvider.getMoreCode().value() == "assert a == 0");
+        REQUIRE_FALSE(codeProvider.getMoreCode().has_value());
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("byte code provider splits the data at line breaks") {
+        std::string data = "1\n2";
+        auto codeProvider = ByteCodeProvider(data.data(), static_cast<long>(data.size()));
+        REQUIRE(codeProvider.getMoreCode().value() == "1");
+        REQUIRE(codeProvider.getMoreCode().value() == "2");
+        REQUIRE_FALSE(codeProvider.getMoreCode().has_value());
+    }
+}
@@ -0,0 +1,35 @@
+#include <catch2/catch.hpp>
+
+#include "CompilerTestHelper.h"
+#include "compiler/Compiler.h"
+
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("Standard library bitcode") {
+    const auto stdLibBitcode = std::filesystem::path(NEON_BUILD_DIRECTORY) / "NeonStd.bc";
+    if (!std::filesystem::exists(stdLibBitcode)) {
+        WARN("NeonStd.bc has not been built, there is no clang for the llvm version the compiler is built against");
+        return;
+    }
+
+    Logger logger = {};
+    const auto buildDirectory = TestBuildDirectory("neon_std_lib_bitcode_test");
+    auto buildEnv = BuildEnv(buildDirectory.path().string());
+    buildEnv.numThreads = 1;
+    buildEnv.optimizationLevel = OptimizationLevel::O2;
+    std::filesystem::copy_file(stdLibBitcode, buildDirectory.path() / "NeonStd.bc",
+                               std::filesystem::copy_options::overwrite_existing);
+
+    auto program = Program("tests/functions_test.ne");
+    REQUIRE_FALSE(Compiler(&program, &buildEnv, logger).run());
+
+    std::string ir = {};
+    {
+        std::ifstream file(buildEnv.buildDirectory + program.name + ".llvm");
+        ir.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE_FALSE(ir.empty());
+    // ftoi is linked in from the bitcode, inlined into its caller and removed afterwards
+    REQUIRE(ir.find("@ftoi") == std::string::npos);
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include "CompilerTestHelper.h"
+#include "compiler/Compiler.h"
+#include "compiler/SymbolIndex.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+TEST_CASE("SymbolIndex") {
+    auto program = Program("main.ne");
+    auto *mainModule = new Module("main.ne", program.llvmContext);
+    auto *importedModule = new Module("imported.ne", program.llvmContext);
+    program.modules["main.ne"] = mainModule;
+    program.modules["imported.ne"] = importedModule;
+
+    const auto f = program.symbols.intern("f");
+    const auto g = program.symbols.intern("g");
+    const auto h = program.symbols.intern("h");
+    std::unordered_map<Module *, ModuleCompileState> moduleCompileState = {};
+    moduleCompileState[mainModule] = {
+          .imports = {"imported.ne"},
+          .functions = {{.name = f, .returnType = ast::DataType(ast::SimpleDataType::INTEGER)}},
+          .complexTypes = {{.type = ast::DataType("Point")}},
+    };
+    moduleCompileState[importedModule] = {
+          .functions = {{.name = f, .returnType = ast::DataType(ast::SimpleDataType::FLOAT)},
+                        {.name = g, .returnType = ast::DataType(ast::SimpleDataType::BOOLEAN)}},
+          .complexTypes = {{.type = ast::DataType("Line")}},
+    };
+    Logger logger = {};
+    const auto index = SymbolIndex(&program, moduleCompileState, logger);
+
+    SECTION("prefers the declarations of the module itself") {
+        const auto result = index.findFunction(mainModule, f);
+        REQUIRE(result.functionExists);
+        REQUIRE(result.module == mainModule);
+        REQUIRE(result.signature == &moduleCompileState[mainModule].functions[0]);
+    }
+
+    SECTION("finds the declarations of imported modules") {
+        const auto function = index.findFunction(mainModule, g);
+        REQUIRE(function.functionExists);
+        REQUIRE(function.module == importedModule);
+        REQUIRE(function.signature->returnType == ast::DataType(ast::SimpleDataType::BOOLEAN));
+
+        const auto type = index.findType(mainModule, ast::DataType("Line"));
+        REQUIRE(type.typeExists);
+        REQUIRE(type.module == importedModule);
+    }
+
+    SECTION("does not see the declarations of modules that import it") {
+        REQUIRE(index.findFunction(importedModule, f).module == importedModule);
+        REQUIRE_FALSE(index.findType(importedModule, ast::DataType("Point")).typeExists);
+        REQUIRE_FALSE(index.findFunction(mainModule, h).functionExists);
+    }
+}
+
+TEST_CASE("SymbolIndex reports imports that have not been loaded") {
+    auto program = Program("main.ne");
+    auto *mainModule = new Module("main.ne", program.llvmContext);
+    program.modules["main.ne"] = mainModule;
+    std::unordered_map<Module *, ModuleCompileState> moduleCompileState = {};
+    moduleCompileState[mainModule] = {.imports = {"missing.ne"}};
+
+    auto output = std::ostringstream();
+    Logger logger = {};
+    logger.setColorEnabled(false);
+    logger.setOutput(&output);
+    const auto index = SymbolIndex(&program, moduleCompileState, logger);
+
+    REQUIRE(program.modules.size() == 1);
+    REQUIRE(output.str().find("missing.ne") != std::string::npos);
+    REQUIRE_FALSE(index.findFunction(mainModule, program.symbols.intern("f")).functionExists);
+}
+
+TEST_CASE("SymbolIndex is rebuilt after updating a module") {
+    Logger logger = {};
+    const auto buildDirectory = TestBuildDirectory("neon_symbol_index_test");
+    auto buildEnv = BuildEnv(buildDirectory.path().string());
+    buildEnv.incrementalParsing = true;
+    buildEnv.numThreads = 1;
+
+    const std::string fileName = "tests/import_test.ne";
+    auto program = Program(fileName);
+    auto compiler = Compiler(&program, &buildEnv, logger);
+    REQUIRE_FALSE(compiler.run());
+
+    const auto size = std::filesystem::file_size(fileName);
+    REQUIRE_FALSE(compiler.updateModule(fileName, size, size, "\nfun answer() int {\n    return 42\n}\n"));
+
+    auto *module = program.modules.at(fileName);
+    const auto answer = compiler.getSymbolIndex().findFunction(module, program.symbols.intern("answer"));
+    REQUIRE(answer.functionExists);
+    REQUIRE(answer.module == module);
+    REQUIRE(answer.signature->returnType == ast::DataType(ast::SimpleDataType::INTEGER));
+
+    // the declarations that existed before the edit have been replaced as well
+    const auto main = compiler.getSymbolIndex().findFunction(module, program.symbols.intern("main"));
+    REQUIRE(main.functionExists);
+    REQUIRE(program.symbols.name(main.signature->name) == "main");
+    REQUIRE(compiler.getSymbolIndex().findFunction(module, program.symbols.intern("floor")).functionExists);
+
+    // the IR of the first run is replaced instead of being generated a second time into the same functions
+    REQUIRE_FALSE(compiler.run());
+    REQUIRE_FALSE(module->llvmModule.getFunction("answer")->isDeclaration());
+    const auto &mainBlocks = module->llvmModule.getFunction("main")->getBasicBlockList();
+    REQUIRE(std::count_if(mainBlocks.begin(), mainBlocks.end(), [](const llvm::BasicBlock &block) {
+                return block.getName().startswith("entry-");
+            }) == 1);
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/SymbolTable.h"
+#include "compiler/lexer/Lexer.h"
+
+#include <thread>
+
+TEST_CASE("SymbolTable") {
+    SECTION("interning the same name twice returns the same id") {
+        auto symbols = SymbolTable();
+        auto first = symbols.intern("hello");
+        auto second = symbols.intern(std::string("hel") + "lo");
+        REQUIRE(first == second);
+        REQUIRE(first != symbols.intern("world"));
+        REQUIRE(symbols.name(first) == "hello");
+    }
+
+    SECTION("the empty name is always interned") {
+        auto symbols = SymbolTable();
+        REQUIRE(symbols.intern("") == NO_SYMBOL);
+        REQUIRE(symbols.size() == 1);
+    }
+
+    SECTION("names stay valid while more names are interned") {
+        auto symbols = SymbolTable();
+        auto id = symbols.intern("a");
+        const std::string &name = symbols.name(id);
+        for (int i = 0; i < 10000; i++) {
+            symbols.intern("variable" + std::to_string(i));
+        }
+        REQUIRE(name == "a");
+        REQUIRE(symbols.intern("variable1234") == symbols.intern("variable1234"));
+    }
+
+    SECTION("lexer interns identifiers") {
+        Logger logger = {};
+        auto symbols = SymbolTable();
+        auto codeProvider = StringCodeProvider({"int a = b + a"}, false);
+        auto lexer = Lexer(&codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
+
+        std::vector<Token> tokens = {};
+        while (true) {
+            auto token = lexer.getToken();
+            if (token.type == Token::INVALID) {
+                break;
+            }
+            tokens.push_back(token);
+        }
+
+        REQUIRE(tokens.size() == 6);
+        REQUIRE(tokens[0].symbol == NO_SYMBOL);
+        REQUIRE(tokens[1].symbol == symbols.intern("a"));
+        REQUIRE(tokens[3].symbol == symbols.intern("b"));
+        REQUIRE(tokens[5].symbol == tokens[1].symbol);
+    }
+
+    SECTION("can be used from several threads") {
+        auto symbols = SymbolTable();
+        const int numThreads = 4;
+        const int numNames = 2000;
+        std::vector<std::vector<SymbolId>> ids(numThreads);
+        std::vector<std::thread> threads = {};
+        for (int t = 0; t < numThreads; t++) {
+            threads.emplace_back([&symbols, &ids, t]() {
+                for (int i = 0; i < numNames; i++) {
+                    ids[t].push_back(symbols.intern("name" + std::to_string(i)));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        REQUIRE(symbols.size() == numNames + 1);
+        for (int t = 1; t < numThreads; t++) {
+            REQUIRE(ids[t] == ids[0]);
+        }
+        REQUIRE(symbols.name(ids[0][42]) == "name42");
+    }
+}
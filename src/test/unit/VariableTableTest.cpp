@@ -0,0 +1,33 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ir/Scope.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+
+TEST_CASE("VariableTable") {
+    llvm::LLVMContext context = {};
+    auto *outer = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 1);
+    auto *inner = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 2);
+    auto *redefined = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 3);
+    const SymbolId a = 1;
+    const SymbolId b = 2;
+
+    auto variables = VariableTable();
+    variables.pushScope();
+    variables.define(a, outer);
+
+    variables.pushScope();
+    variables.define(a, inner);
+    variables.define(b, inner);
+    variables.define(a, redefined);
+    REQUIRE(variables.find(a) == redefined);
+    REQUIRE(variables.find(b) == inner);
+    variables.popScope();
+
+    REQUIRE(variables.find(a) == outer);
+    REQUIRE(variables.find(b) == nullptr);
+
+    variables.popScope();
+    REQUIRE(variables.find(a) == nullptr);
+}
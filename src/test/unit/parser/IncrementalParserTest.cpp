@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include "ParserTestHelper.h"
+
+#include "compiler/parser/IncrementalParser.h"
+#include "compiler/parser/Parser.h"
+
+namespace {
+
+std::string createProgram(int numFunctions) {
+    std::string result = "# generated\n\n";
+    for (int i = 0; i < numFunctions; i++) {
+        result += "fun f" + std::to_string(i) + "(int a) int {\n";
+        result += "    int b = a * " + std::to_string(i) + "\n";
+        result += "    return b + 1\n";
+        result += "}\n\n";
+    }
+    result += "a = 1 b = 2\n";
+    return result;
+}
+
+SimpleTree *parseFully(const std::string &code, SymbolTable &symbols, llvm::LLVMContext &context) {
+    Logger logger = {};
+    auto module = Module("full.ne", context);
+    auto codeProvider = BufferCodeProvider(code);
+    auto lexer = Lexer(&codeProvider, logger);
+    Parser(logger, lexer, symbols).run(&module);
+    REQUIRE(module.ast.is_complete());
+    return createSimpleFromAst(module.ast.root());
+}
+
+} // namespace
+
+TEST_CASE("IncrementalParser") {
+    Logger logger = {};
+    llvm::LLVMContext context = {};
+    auto symbols = SymbolTable();
+
+    auto code = createProgram(1000);
+    auto codeProvider = BufferCodeProvider(code);
+    auto module = Module("test.ne", context);
+    module.codeProvider = &codeProvider;
+
+    auto parser = IncrementalParser(logger, symbols);
+    REQUIRE(parser.run(&module));
+    REQUIRE(module.ast.is_complete());
+    REQUIRE(IncrementalParser::getCode(&module) == code);
+    REQUIRE(astsAreEqual(parseFully(code, symbols, context), createSimpleFromAst(module.ast.root()), 0));
+    // a comment, one segment per function and two statements that share a line
+    REQUIRE(module.ast.root()->sequence.children.size() == 1003);
+    REQUIRE(module.segments.size() == 1002);
+
+    SECTION("only re-parses the edited function") {
+        const std::string line = "    int b = a * 500\n";
+        const auto begin = code.find(line);
+        const auto replacement = std::string("    int b = a * 500\n    b = b - 2\n");
+        auto *untouchedStatement = module.ast.root()->sequence.children[10];
+
+        REQUIRE(parser.applyEdit(&module, begin, begin + line.size(), replacement));
+        code.replace(begin, line.size(), replacement);
+
+        REQUIRE(parser.getReparsedBytes() < 100);
+        REQUIRE(IncrementalParser::getCode(&module) == code);
+        REQUIRE(module.ast.root()->sequence.children[10] == untouchedStatement);
+        REQUIRE(astsAreEqual(parseFully(code, symbols, context), createSimpleFromAst(module.ast.root()), 0));
+    }
+
+    SECTION("merges statements that end up on the same line") {
+        const auto begin = code.find("}\n\nfun f7(");
+        REQUIRE(parser.applyEdit(&module, begin + 1, begin + 3, " "));
+        code.replace(begin + 1, 2, " ");
+
+        REQUIRE(parser.getReparsedBytes() < 200);
+        REQUIRE(module.ast.root()->sequence.children.size() == 1003);
+        REQUIRE(module.segments.size() == 1001);
+        REQUIRE(astsAreEqual(parseFully(code, symbols, context), createSimpleFromAst(module.ast.root()), 0));
+    }
+
+    SECTION("reuses the nodes of the replaced statements") {
+        const std::string line = "    return b + 1\n";
+        const auto begin = code.find(line);
+        REQUIRE(parser.applyEdit(&module, begin, begin + line.size(), "    return b + 2\n"));
+        const auto sizeAfterFirstEdit = module.ast.size();
+
+        for (int i = 0; i < 10; i++) {
+            const auto replacement = "    return b + " + std::to_string(i) + "\n";
+            REQUIRE(parser.applyEdit(&module, begin, begin + line.size(), replacement));
+            code.replace(begin, line.size(), replacement);
+        }
+
+        REQUIRE(module.ast.size() == sizeAfterFirstEdit);
+        REQUIRE(astsAreEqual(parseFully(code, symbols, context), createSimpleFromAst(module.ast.root()), 0));
+    }
+
+    SECTION("leaves the module untouched if the edit contains a syntax error") {
+        const auto begin = code.find("return b + 1");
+        REQUIRE_FALSE(parser.applyEdit(&module, begin, begin + 6, "retrun"));
+
+        REQUIRE(IncrementalParser::getCode(&module) == code);
+        REQUIRE(module.ast.root()->sequence.children.size() == 1003);
+    }
+}
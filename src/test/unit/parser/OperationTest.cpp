@@ -173,4 +173,39 @@ TEST_CASE("Parser Operations") {
         };
         REQUIRE(parserCreatesCorrectAst(program, spec));
     }
+
+    SECTION("can handle mixed operator precedence") {
+        std::vector<AstNodeSpec> spec = {
+              {0, ast::NodeType::SEQUENCE},         {1, ast::NodeType::STATEMENT},
+              {2, ast::NodeType::ASSIGNMENT},       {3, ast::NodeType::VARIABLE_DEFINITION},
+              {3, ast::NodeType::BINARY_OPERATION}, {4, ast::NodeType::BINARY_OPERATION},
+              {5, ast::NodeType::BINARY_OPERATION}, {6, ast::NodeType::BINARY_OPERATION},
+              {7, ast::NodeType::LITERAL},          {7, ast::NodeType::LITERAL},
+              {6, ast::NodeType::BINARY_OPERATION}, {7, ast::NodeType::LITERAL},
+              {7, ast::NodeType::LITERAL},          {5, ast::NodeType::LITERAL},
+              {4, ast::NodeType::BINARY_OPERATION}, {5, ast::NodeType::VARIABLE},
+              {5, ast::NodeType::VARIABLE},
+        };
+        std::vector<std::string> program = {"bool a = 1 - 1 + 2 * 3 < 4 and b == c"};
+        REQUIRE(parserCreatesCorrectAst(program, spec));
+    }
+
+    SECTION("can handle deeply nested operations") {
+        const int depth = 1000;
+        std::vector<AstNodeSpec> spec = {
+              {0, ast::NodeType::SEQUENCE},
+              {1, ast::NodeType::STATEMENT},
+              {2, ast::NodeType::ASSIGNMENT},
+              {3, ast::NodeType::VARIABLE_DEFINITION},
+        };
+        std::string expression = "1";
+        for (int i = 0; i < depth; i++) {
+            spec.push_back({3 + i, ast::NodeType::BINARY_OPERATION});
+            spec.push_back({4 + i, ast::NodeType::LITERAL});
+            expression = "(1 + " + expression + ")";
+        }
+        spec.push_back({3 + depth, ast::NodeType::LITERAL});
+        std::vector<std::string> program = {"int a = " + expression};
+        REQUIRE(parserCreatesCorrectAst(program, spec));
+    }
 }
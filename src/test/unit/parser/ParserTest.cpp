@@ -2,6 +2,10 @@
 
 #include "ParserTestHelper.h"
 
+#include "compiler/parser/Parser.h"
+
+#include <filesystem>
+
 TEST_CASE("Parser") {
     SECTION("can handle variables") {
         std::vector<AstNodeSpec> spec = {
@@ -29,4 +33,72 @@ TEST_CASE("Parser") {
         std::vector<std::string> program = {"int world = hello.world", "float x = hello.world.x"};
         REQUIRE(parserCreatesCorrectAst(program, spec));
     }
+
+    SECTION("streaming mode creates the same ast as buffered mode") {
+        for (const auto &entry : std::filesystem::directory_iterator(NEON_TEST_PROGRAMS_DIRECTORY)) {
+            if (entry.path().extension() != ".ne") {
+                continue;
+            }
+
+            INFO(entry.path().string());
+            Logger logger = {};
+            llvm::LLVMContext context = {};
+            auto symbols = SymbolTable();
+
+            auto bufferedModule = Module(entry.path(), context);
+            auto bufferedLexer = Lexer(bufferedModule.getCodeProvider(), logger);
+            Parser(logger, bufferedLexer, symbols, Parser::Mode::BUFFERED).run(&bufferedModule);
+
+            auto streamingModule = Module(entry.path(), context);
+            auto streamingLexer = Lexer(streamingModule.getCodeProvider(), logger);
+            Parser(logger, streamingLexer, symbols, Parser::Mode::STREAMING).run(&streamingModule);
+
+            REQUIRE(bufferedModule.ast.is_complete());
+            REQUIRE(streamingModule.ast.is_complete());
+            REQUIRE(streamingModule.tokens.empty());
+            REQUIRE(astsAreEqual(createSimpleFromAst(bufferedModule.ast.root()),
+                                 createSimpleFromAst(streamingModule.ast.root()), 0));
+        }
+    }
+
+    SECTION("does not backtrack on the test programs") {
+        for (const auto &entry : std::filesystem::directory_iterator(NEON_TEST_PROGRAMS_DIRECTORY)) {
+            if (entry.path().extension() != ".ne") {
+                continue;
+            }
+
+            INFO(entry.path().string());
+            Logger logger = {};
+            llvm::LLVMContext context = {};
+            auto symbols = SymbolTable();
+            auto module = Module(entry.path(), context);
+            auto lexer = Lexer(module.getCodeProvider(), logger);
+            Parser parser(logger, lexer, symbols);
+            parser.run(&module);
+
+            REQUIRE(module.ast.is_complete());
+            REQUIRE(parser.getBacktrackedTokens() == 0);
+        }
+    }
+
+    SECTION("streaming mode keeps the token window small") {
+        std::vector<std::string> program = {"fun main() int {"};
+        for (int i = 0; i < 5000; i++) {
+            program.push_back("int a" + std::to_string(i) + " = " + std::to_string(i) + " * (3 + 4)");
+        }
+        program.emplace_back("return 0");
+        program.emplace_back("}");
+
+        Logger logger = {};
+        llvm::LLVMContext context = {};
+        auto symbols = SymbolTable();
+        auto module = Module("test.ne", context);
+        auto codeProvider = StringCodeProvider(program, true);
+        auto lexer = Lexer(&codeProvider, logger);
+        Parser parser(logger, lexer, symbols, Parser::Mode::STREAMING);
+        parser.run(&module);
+
+        REQUIRE(module.ast.is_complete());
+        REQUIRE(parser.getMaxWindowSize() < 32);
+    }
 }
@@ -211,23 +211,29 @@ SimpleTree *createSimpleFromAst(AstNode *node) {
 bool parserCreatesCorrectAst(const std::vector<std::string> &program, std::vector<AstNodeSpec> &spec) {
     int index = 0;
     auto expected = createSimpleFromSpecification(spec, index);
-    CodeProvider *codeProvider = new StringCodeProvider(program, true);
-    auto context = new llvm::LLVMContext();
-    auto prog = new Module("test.ne", *context);
-    Logger logger = {};
-    logger.setColorEnabled(false);
-    auto lexer = Lexer(codeProvider, logger);
-
-    Parser parser(logger, lexer);
-    parser.run(prog);
-
-    /*
-     * TODO activate this again
-        auto astPrinter = AstPrinter(prog);
-        std::string result = astPrinter.run();
-        UNSCOPED_INFO(result);
-    */
-
-    auto actual = prog->ast.root();
-    return astsAreEqual(expected, createSimpleFromAst(actual), 0);
+    for (auto mode : {Parser::Mode::BUFFERED, Parser::Mode::STREAMING}) {
+        CodeProvider *codeProvider = new StringCodeProvider(program, true);
+        auto context = new llvm::LLVMContext();
+        auto prog = new Module("test.ne", *context);
+        Logger logger = {};
+        logger.setColorEnabled(false);
+        auto symbols = SymbolTable();
+        auto lexer = Lexer(codeProvider, logger, Lexer::Mode::TABLE_DRIVEN, &symbols);
+
+        Parser parser(logger, lexer, symbols, mode);
+        parser.run(prog);
+
+        /*
+         * TODO activate this again
+            auto astPrinter = AstPrinter(prog);
+            std::string result = astPrinter.run();
+            UNSCOPED_INFO(result);
+        */
+
+        auto actual = prog->ast.root();
+        if (!astsAreEqual(expected, createSimpleFromAst(actual), 0)) {
+            return false;
+        }
+    }
+    return true;
 }
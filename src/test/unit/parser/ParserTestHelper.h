@@ -17,4 +17,6 @@ struct SimpleTree {
 
 SimpleTree *createSimpleFromAst(AstNode *node);
 
+bool astsAreEqual(SimpleTree *expected, SimpleTree *actual, int level);
+
 bool parserCreatesCorrectAst(const std::vector<std::string> &program, std::vector<AstNodeSpec> &spec);